@@ -42,6 +42,8 @@ public class MultiplayerSessionsSubsystem : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
+				"EngineSettings",
+				"Json"
 			}
 			);
 		
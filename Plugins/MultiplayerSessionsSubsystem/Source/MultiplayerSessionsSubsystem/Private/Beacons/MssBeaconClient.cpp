@@ -0,0 +1,131 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#include "Beacons/MssBeaconClient.h"
+
+#include "Beacons/MssBeaconHostObject.h"
+#include "System/MssLogger.h"
+
+bool AMssBeaconClient::RequestReservation(const FString& InConnectInfo, const FString& InSessionKey,
+	const FUniqueNetIdRepl& InPlayerId, int32 InPartySize)
+{
+	LOG_INFO(TEXT("Requesting %d slot(s) on session %s at %s"), InPartySize, *InSessionKey, *InConnectInfo);
+	
+	PendingSessionKey = InSessionKey;
+	PendingPlayerId = InPlayerId;
+	PendingPartySize = FMath::Max(1, InPartySize);
+
+	return ConnectForRequest(InConnectInfo, EMssBeaconRequest::Reservation);
+}
+
+bool AMssBeaconClient::RequestPing(const FString& InConnectInfo)
+{
+	return ConnectForRequest(InConnectInfo, EMssBeaconRequest::Ping);
+}
+
+bool AMssBeaconClient::ConnectForRequest(const FString& InConnectInfo, EMssBeaconRequest InRequest)
+{
+	PendingRequest = InRequest;
+	bRequestCompleted = false;
+
+	FURL ConnectURL(nullptr, *InConnectInfo, TRAVEL_Absolute);
+	if (!InitClient(ConnectURL))
+	{
+		LOG_ERROR(TEXT("Failed to start the beacon connection to %s"), *InConnectInfo);
+		return false;
+	}
+	
+	return true;
+}
+
+void AMssBeaconClient::OnConnected()
+{
+	Super::OnConnected();
+
+	switch (PendingRequest)
+	{
+	case EMssBeaconRequest::Reservation:
+		LOG_INFO(TEXT("Beacon connected, sending reservation request"));
+		ServerRequestReservation(PendingSessionKey, PendingPlayerId, PendingPartySize);
+		break;
+	case EMssBeaconRequest::Ping:
+		PingSentAtSeconds = FPlatformTime::Seconds();
+		ServerPing();
+		break;
+	case EMssBeaconRequest::None:
+		break;
+	}
+}
+
+void AMssBeaconClient::OnFailure()
+{
+	LOG_WARNING(TEXT("Beacon connection failed"));
+
+	switch (PendingRequest)
+	{
+	case EMssBeaconRequest::Reservation:
+		CompleteReservation(EMssReservationResult::ConnectionFailed);
+		break;
+	case EMssBeaconRequest::Ping:
+		CompletePing(INDEX_NONE);
+		break;
+	case EMssBeaconRequest::None:
+		break;
+	}
+	
+	Super::OnFailure();
+}
+
+bool AMssBeaconClient::ServerRequestReservation_Validate(const FString& InSessionKey, const FUniqueNetIdRepl& InPlayerId, int32 InPartySize)
+{
+	return InPartySize > 0 && InPlayerId.IsValid();
+}
+
+void AMssBeaconClient::ServerRequestReservation_Implementation(const FString& InSessionKey, const FUniqueNetIdRepl& InPlayerId, int32 InPartySize)
+{
+	AMssBeaconHostObject* HostObject = Cast<AMssBeaconHostObject>(GetBeaconOwner());
+	if (!HostObject)
+	{
+		LOG_ERROR(TEXT("Reservation request received without a host object"));
+		ClientReservationResponse(EMssReservationResult::SessionMismatch);
+		return;
+	}
+	
+	ClientReservationResponse(HostObject->ProcessReservationRequest(InSessionKey, InPlayerId, InPartySize));
+}
+
+void AMssBeaconClient::ClientReservationResponse_Implementation(EMssReservationResult Result)
+{
+	CompleteReservation(Result);
+}
+
+void AMssBeaconClient::ServerPing_Implementation()
+{
+	ClientPong();
+}
+
+void AMssBeaconClient::ClientPong_Implementation()
+{
+	CompletePing(FMath::RoundToInt32((FPlatformTime::Seconds() - PingSentAtSeconds) * 1000.0));
+}
+
+void AMssBeaconClient::CompleteReservation(EMssReservationResult Result)
+{
+	if (bRequestCompleted)
+		return;
+
+	bRequestCompleted = true;
+	
+	LOG_INFO(TEXT("Reservation result : %s"), *UEnum::GetValueAsString(Result));
+	
+	OnReservationResponse.ExecuteIfBound(Result);
+}
+
+void AMssBeaconClient::CompletePing(int32 RoundTripMs)
+{
+	if (bRequestCompleted)
+		return;
+
+	bRequestCompleted = true;
+	
+	OnPingMeasured.ExecuteIfBound(RoundTripMs);
+}
@@ -0,0 +1,139 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#include "Beacons/MssBeaconHostObject.h"
+
+#include "OnlineSessionSettings.h"
+#include "OnlineSubsystemUtils.h"
+#include "Online/OnlineSessionNames.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "System/MssLogger.h"
+#include "TimerManager.h"
+
+AMssBeaconHostObject::AMssBeaconHostObject()
+{
+	ClientBeaconActorClass = AMssBeaconClient::StaticClass();
+	BeaconTypeName = ClientBeaconActorClass->GetName();
+}
+
+void AMssBeaconHostObject::BeginPlay()
+{
+	Super::BeginPlay();
+
+	GameModePostLoginDelegateHandle = FGameModeEvents::GameModePostLoginEvent.AddUObject(this, &ThisClass::OnGameModePostLogin);
+	
+	GetWorldTimerManager().SetTimer(PruneReservationsTimerHandle, this, &ThisClass::PruneExpiredReservations, 1.f, true);
+}
+
+void AMssBeaconHostObject::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FGameModeEvents::GameModePostLoginEvent.Remove(GameModePostLoginDelegateHandle);
+	
+	GetWorldTimerManager().ClearTimer(PruneReservationsTimerHandle);
+	
+	Reservations.Empty();
+	
+	Super::EndPlay(EndPlayReason);
+}
+
+EMssReservationResult AMssBeaconHostObject::ProcessReservationRequest(const FString& InSessionKey, 
+	const FUniqueNetIdRepl& InPlayerId, int32 InPartySize)
+{
+	PruneExpiredReservations();
+
+	const IOnlineSessionPtr SessionInterface = Online::GetSessionInterface(GetWorld());
+	const FNamedOnlineSession* Session = SessionInterface.IsValid() ? SessionInterface->GetNamedSession(NAME_GameSession) : nullptr;
+	if (!Session)
+	{
+		LOG_WARNING(TEXT("Rejecting reservation, no session is hosted"));
+		return EMssReservationResult::SessionMismatch;
+	}
+
+	FString HostSessionKey;
+	Session->SessionSettings.Get(SETTING_SESSIONKEY, HostSessionKey);
+	if (InSessionKey != HostSessionKey)
+	{
+		LOG_WARNING(TEXT("Rejecting reservation for session %s, hosting %s"), *InSessionKey, *HostSessionKey);
+		return EMssReservationResult::SessionMismatch;
+	}
+
+	// A retry from the same leader replaces its previous reservation instead of holding the slots twice
+	Reservations.RemoveAll([&InPlayerId](const FMssReservation& Reservation)
+	{
+		return Reservation.PlayerId == InPlayerId;
+	});
+
+	const AGameModeBase* GameMode = GetWorld()->GetAuthGameMode();
+	const int32 NumPlayers = GameMode ? GameMode->GetNumPlayers() : 0;
+	const int32 OpenSlots = Session->SessionSettings.NumPublicConnections - NumPlayers - GetNumReservedSlots();
+	
+	if (InPartySize > OpenSlots)
+	{
+		LOG_INFO(TEXT("Rejecting reservation of %d slot(s), %d open"), InPartySize, OpenSlots);
+		return EMssReservationResult::SessionFull;
+	}
+
+	FMssReservation& Reservation = Reservations.AddDefaulted_GetRef();
+	Reservation.PlayerId = InPlayerId;
+	Reservation.PartySize = InPartySize;
+	Reservation.ExpiresAtSeconds = FPlatformTime::Seconds() + ReservationLifetimeInSeconds;
+
+	LOG_INFO(TEXT("Reserved %d slot(s) for %s, %d open left"), InPartySize, *InPlayerId.ToString(), OpenSlots - InPartySize);
+	
+	return EMssReservationResult::Accepted;
+}
+
+int32 AMssBeaconHostObject::GetNumReservedSlots() const
+{
+	// The prune timer only runs once a second, an expired reservation must not hold slots until then
+	const double NowSeconds = FPlatformTime::Seconds();
+	
+	int32 NumReservedSlots = 0;
+	for (const FMssReservation& Reservation : Reservations)
+	{
+		if (Reservation.ExpiresAtSeconds > NowSeconds)
+		{
+			NumReservedSlots += Reservation.PartySize;
+		}
+	}
+	
+	return NumReservedSlots;
+}
+
+int32 AMssBeaconHostObject::GetReservedPartySize(const FUniqueNetIdRepl& InPlayerId) const
+{
+	const double NowSeconds = FPlatformTime::Seconds();
+	
+	const FMssReservation* PlayerReservation = Reservations.FindByPredicate([&InPlayerId, NowSeconds](const FMssReservation& Reservation)
+	{
+		return Reservation.PlayerId == InPlayerId && Reservation.ExpiresAtSeconds > NowSeconds;
+	});
+	
+	return PlayerReservation ? PlayerReservation->PartySize : 0;
+}
+
+void AMssBeaconHostObject::OnGameModePostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer)
+{
+	if (!GameMode || GameMode->GetWorld() != GetWorld() || !NewPlayer || !NewPlayer->PlayerState)
+		return;
+
+	const FUniqueNetIdRepl& PlayerId = NewPlayer->PlayerState->GetUniqueId();
+	
+	// The whole party is released with its leader, members that follow are counted as regular players
+	if (Reservations.RemoveAll([&PlayerId](const FMssReservation& Reservation) { return Reservation.PlayerId == PlayerId; }) > 0)
+	{
+		LOG_INFO(TEXT("Reservation of %s consumed on login"), *PlayerId.ToString());
+	}
+}
+
+void AMssBeaconHostObject::PruneExpiredReservations()
+{
+	const double NowSeconds = FPlatformTime::Seconds();
+	
+	if (const int32 NumExpired = Reservations.RemoveAll([NowSeconds](const FMssReservation& Reservation) { return Reservation.ExpiresAtSeconds <= NowSeconds; }))
+	{
+		LOG_INFO(TEXT("%d unused reservation(s) expired"), NumExpired);
+	}
+}
@@ -0,0 +1,272 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#include "Bots/MssBotSubsystem.h"
+
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Subsystem/MssSubsystem.h"
+#include "System/MssLogger.h"
+#include "TimerManager.h"
+#include "UObject/UObjectGlobals.h"
+
+bool UMssBotSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("bot")) && !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UMssBotSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	MssSubsystem = Collection.InitializeDependency<UMssSubsystem>();
+	if (!MssSubsystem)
+	{
+		LOG_ERROR(TEXT("Bot mode needs the session subsystem"));
+		return;
+	}
+
+	ParseScript();
+	FParse::Value(FCommandLine::Get(), TEXT("MssBotCycles="), MaxCycles);
+	FParse::Value(FCommandLine::Get(), TEXT("MssBotStepTimeout="), StepTimeoutInSeconds);
+	InputPhase = FMath::FRandRange(0.f, 2.f * PI);
+
+	MssSubsystem->MultiplayerSessionsOnFindSessionsComplete.AddUObject(this, &ThisClass::OnFindSessionsComplete);
+	MssSubsystem->MultiplayerSessionsOnJoinSessionsComplete.AddUObject(this, &ThisClass::OnJoinSessionComplete);
+	MssSubsystem->MultiplayerSessionsOnDestroySessionComplete.AddDynamic(this, &ThisClass::OnDestroySessionComplete);
+
+	PostLoadMapWithWorldDelegateHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::OnPostLoadMapWithWorld);
+
+	LOG_INFO(TEXT("Bot mode, %d step(s), %d cycle(s)"), Script.Num(), MaxCycles);
+}
+
+void UMssBotSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapWithWorldDelegateHandle);
+
+	if (MssSubsystem)
+	{
+		MssSubsystem->MultiplayerSessionsOnFindSessionsComplete.RemoveAll(this);
+		MssSubsystem->MultiplayerSessionsOnJoinSessionsComplete.RemoveAll(this);
+		MssSubsystem->MultiplayerSessionsOnDestroySessionComplete.RemoveAll(this);
+	}
+
+	GetGameInstance()->GetTimerManager().ClearAllTimersForObject(this);
+
+	LOG_INFO(TEXT("Bot finished %d cycle(s)"), CompletedCycles);
+	
+	Super::Deinitialize();
+}
+
+void UMssBotSubsystem::ParseScript()
+{
+	FString ScriptString = TEXT("find,join,play=30,destroy,wait=2");
+	FParse::Value(FCommandLine::Get(), TEXT("MssBotScript="), ScriptString, false);
+
+	TArray<FString> Tokens;
+	ScriptString.ParseIntoArray(Tokens, TEXT(","));
+
+	const UEnum* StepEnum = StaticEnum<EMssBotStep>();
+	
+	for (const FString& Token : Tokens)
+	{
+		FString StepName = Token.TrimStartAndEnd();
+		FString SecondsString;
+		Token.TrimStartAndEnd().Split(TEXT("="), &StepName, &SecondsString);
+
+		int32 StepEnumIndex = INDEX_NONE;
+		for (int32 EnumIndex = 0; EnumIndex < StepEnum->NumEnums() - 1; ++EnumIndex)
+		{
+			if (StepEnum->GetNameStringByIndex(EnumIndex).Equals(StepName, ESearchCase::IgnoreCase))
+			{
+				StepEnumIndex = EnumIndex;
+				break;
+			}
+		}
+		
+		if (StepEnumIndex == INDEX_NONE)
+		{
+			LOG_WARNING(TEXT("Unknown bot step '%s' skipped"), *Token);
+			continue;
+		}
+
+		FMssBotScriptStep& ScriptStep = Script.AddDefaulted_GetRef();
+		ScriptStep.Step = static_cast<EMssBotStep>(StepEnum->GetValueByIndex(StepEnumIndex));
+		ScriptStep.Seconds = SecondsString.IsEmpty() ? 0.f : FCString::Atof(*SecondsString);
+	}
+}
+
+void UMssBotSubsystem::OnPostLoadMapWithWorld(UWorld* LoadedWorld)
+{
+	if (bScriptStarted || Script.IsEmpty())
+		return;
+
+	bScriptStarted = true;
+	
+	RunStep();
+}
+
+EMssBotStep UMssBotSubsystem::GetCurrentStep() const
+{
+	return Script.IsValidIndex(StepIndex) ? Script[StepIndex].Step : EMssBotStep::Wait;
+}
+
+void UMssBotSubsystem::RunStep()
+{
+	const FMssBotScriptStep& ScriptStep = Script[StepIndex];
+	
+	LOG_INFO(TEXT("Cycle %d step %d : %s"), CompletedCycles, StepIndex, *UEnum::GetValueAsString(ScriptStep.Step));
+
+	FTimerManager& TimerManager = GetGameInstance()->GetTimerManager();
+	
+	// Armed before the request, an answer broadcast synchronously from inside it replaces the timer with the next step's
+	if (ScriptStep.Step == EMssBotStep::Find || ScriptStep.Step == EMssBotStep::Join || ScriptStep.Step == EMssBotStep::Destroy)
+	{
+		TimerManager.SetTimer(StepTimerHandle, this, &ThisClass::OnStepTimedOut, FMath::Max(StepTimeoutInSeconds, 1.f), false);
+	}
+	
+	switch (ScriptStep.Step)
+	{
+	case EMssBotStep::Find:
+		MssSubsystem->FindSessions();
+		break;
+		
+	case EMssBotStep::Join:
+		if (!SessionToJoin.IsValid())
+		{
+			LOG_WARNING(TEXT("Nothing to join, run a find step first"));
+			RestartScript(1.f);
+			return;
+		}
+		MssSubsystem->JoinSessions(SessionToJoin);
+		break;
+		
+	case EMssBotStep::Play:
+		PlayedSeconds = 0.f;
+		TimerManager.SetTimer(InputTimerHandle, this, &ThisClass::SendSyntheticInput, InputIntervalInSeconds, true);
+		TimerManager.SetTimer(StepTimerHandle, FTimerDelegate::CreateWeakLambda(this, [this]()
+		{
+			GetGameInstance()->GetTimerManager().ClearTimer(InputTimerHandle);
+			AdvanceStep();
+		}), FMath::Max(ScriptStep.Seconds, InputIntervalInSeconds), false);
+		break;
+		
+	case EMssBotStep::Destroy:
+		MssSubsystem->DestroySession();
+		break;
+		
+	case EMssBotStep::Wait:
+		TimerManager.SetTimer(StepTimerHandle, this, &ThisClass::AdvanceStep, FMath::Max(ScriptStep.Seconds, KINDA_SMALL_NUMBER), false);
+		break;
+	}
+}
+
+void UMssBotSubsystem::AdvanceStep()
+{
+	if (++StepIndex < Script.Num())
+	{
+		RunStep();
+		return;
+	}
+
+	StepIndex = 0;
+	++CompletedCycles;
+	
+	if (MaxCycles > 0 && CompletedCycles >= MaxCycles)
+	{
+		LOG_INFO(TEXT("Bot completed %d cycle(s), exiting"), CompletedCycles);
+		GetGameInstance()->GetTimerManager().ClearTimer(StepTimerHandle);
+		FPlatformMisc::RequestExit(false, TEXT("MssBot"));
+		return;
+	}
+
+	RunStep();
+}
+
+void UMssBotSubsystem::RestartScript(float InDelayInSeconds)
+{
+	StepIndex = 0;
+	
+	GetGameInstance()->GetTimerManager().SetTimer(StepTimerHandle, this, &ThisClass::RunStep, FMath::Max(InDelayInSeconds, KINDA_SMALL_NUMBER), false);
+}
+
+void UMssBotSubsystem::OnStepTimedOut()
+{
+	LOG_WARNING(TEXT("No answer to %s within %.0f second(s), starting over"), *UEnum::GetValueAsString(GetCurrentStep()), StepTimeoutInSeconds);
+	
+	SessionToJoin = FOnlineSessionSearchResult();
+	RestartScript(1.f);
+}
+
+void UMssBotSubsystem::SendSyntheticInput()
+{
+	const UWorld* World = GetGameInstance()->GetWorld();
+	APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+	
+	// Still travelling or waiting to be possessed
+	if (!Pawn)
+		return;
+
+	PlayedSeconds += InputIntervalInSeconds;
+
+	// Wanders in slow curves and looks around, roughly what a player browsing the lobby does
+	const float Time = PlayedSeconds + InputPhase;
+	PlayerController->AddYawInput(FMath::Sin(Time * 0.5f) * 90.f * InputIntervalInSeconds);
+	PlayerController->AddPitchInput(FMath::Sin(Time * 1.3f) * 20.f * InputIntervalInSeconds);
+
+	const FRotator YawRotation(0.f, PlayerController->GetControlRotation().Yaw, 0.f);
+	Pawn->AddMovementInput(FRotationMatrix(YawRotation).GetUnitAxis(EAxis::X), 1.f);
+	Pawn->AddMovementInput(FRotationMatrix(YawRotation).GetUnitAxis(EAxis::Y), FMath::Sin(Time * 0.7f));
+}
+
+void UMssBotSubsystem::OnFindSessionsComplete(const TArray<FOnlineSessionSearchResult>& SessionResults, bool bWasSuccessful)
+{
+	if (GetCurrentStep() != EMssBotStep::Find)
+		return;
+
+	if (!MssSubsystem->GetLowestLatencySearchResult(SessionToJoin))
+	{
+		LOG_INFO(TEXT("No open session found, searching again"));
+		GetGameInstance()->GetTimerManager().SetTimer(StepTimerHandle, this, &ThisClass::RunStep, 1.f, false);
+		return;
+	}
+
+	AdvanceStep();
+}
+
+void UMssBotSubsystem::OnJoinSessionComplete(EOnJoinSessionCompleteResult::Type Result)
+{
+	if (GetCurrentStep() != EMssBotStep::Join)
+		return;
+
+	// Shares the duplicate travel guard and replay handling of every other join
+	if (Result != EOnJoinSessionCompleteResult::Success || !MssSubsystem->ClientTravelToSession())
+	{
+		LOG_WARNING(TEXT("Join failed (%s), starting over"), LexToString(Result));
+		MssSubsystem->ReleasePreloadedMap();
+		SessionToJoin = FOnlineSessionSearchResult();
+		RestartScript(1.f);
+		return;
+	}
+	
+	AdvanceStep();
+}
+
+void UMssBotSubsystem::OnDestroySessionComplete(bool bWasSuccessful)
+{
+	if (GetCurrentStep() != EMssBotStep::Destroy)
+		return;
+
+	if (APlayerController* PlayerController = GetGameInstance()->GetFirstLocalPlayerController())
+	{
+		PlayerController->ClientReturnToMainMenuWithTextReason(FText::FromString(TEXT("Bot cycle complete")));
+	}
+
+	SessionToJoin = FOnlineSessionSearchResult();
+	
+	AdvanceStep();
+}
@@ -0,0 +1,237 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#include "Lobby/MssLobbyAutoStartComponent.h"
+
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "Misc/PackageName.h"
+#include "Subsystem/MssSubsystem.h"
+#include "System/MssLogger.h"
+#include "TimerManager.h"
+
+UMssLobbyAutoStartComponent::UMssLobbyAutoStartComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UMssLobbyAutoStartComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	const UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	MssSubsystem = GameInstance ? GameInstance->GetSubsystem<UMssSubsystem>() : nullptr;
+	if (!GetGameMode() || !MssSubsystem)
+		return;
+
+	// Only a lobby still waiting for players is started, a running match is left alone
+	if (!MssSubsystem->IsHostedSessionPending())
+		return;
+
+	FTempCustomSessionSettings HostedSessionSettings;
+	MssSubsystem->GetHostedSessionSettings(HostedSessionSettings);
+	RequiredPlayers = UMssSubsystem::GetRequiredPlayerCount(HostedSessionSettings.Players);
+
+	PostLoginDelegateHandle = FGameModeEvents::GameModePostLoginEvent.AddUObject(this, &ThisClass::OnPostLogin);
+	LogoutDelegateHandle = FGameModeEvents::GameModeLogoutEvent.AddUObject(this, &ThisClass::OnLogout);
+	MssSubsystem->MultiplayerSessionsOnStartSessionComplete.AddDynamic(this, &ThisClass::OnStartSessionComplete);
+
+	FString ResolvedMatchMapPath;
+	if (!ResolveMatchMapPath(ResolvedMatchMapPath))
+	{
+		LOG_ERROR(TEXT("No match map, neither MatchMapPath '%s' nor the hosted map '%s' is an existing map, the lobby will not start"),
+			*MatchMapPath, *HostedSessionSettings.MapName);
+	}
+
+	LOG_INFO(TEXT("Lobby waiting for %d player(s), match map '%s'"), RequiredPlayers, *ResolvedMatchMapPath);
+
+	// The host itself has logged in before any component begins play
+	EvaluateLobby();
+}
+
+void UMssLobbyAutoStartComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FGameModeEvents::GameModePostLoginEvent.Remove(PostLoginDelegateHandle);
+	FGameModeEvents::GameModeLogoutEvent.Remove(LogoutDelegateHandle);
+
+	if (MssSubsystem)
+	{
+		MssSubsystem->MultiplayerSessionsOnStartSessionComplete.RemoveDynamic(this, &ThisClass::OnStartSessionComplete);
+	}
+
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearAllTimersForObject(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+AGameModeBase* UMssLobbyAutoStartComponent::GetGameMode() const
+{
+	return Cast<AGameModeBase>(GetOwner());
+}
+
+void UMssLobbyAutoStartComponent::OnPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer)
+{
+	if (GameMode == GetGameMode())
+	{
+		EvaluateLobby();
+	}
+}
+
+void UMssLobbyAutoStartComponent::OnLogout(AGameModeBase* GameMode, AController* Exiting)
+{
+	// Logout fires before the leaving player is removed from the count
+	if (GameMode == GetGameMode())
+	{
+		EvaluateLobby(-1);
+	}
+}
+
+void UMssLobbyAutoStartComponent::EvaluateLobby(int32 InPlayerCountDelta)
+{
+	if (bStartRequested)
+		return;
+
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	const int32 NumPlayers = GetGameMode()->GetNumPlayers() + InPlayerCountDelta;
+	const bool bHasMinPlayers = MinPlayersToStart > 0 && NumPlayers >= MinPlayersToStart;
+
+	LOG_INFO(TEXT("Lobby has %d / %d player(s)"), NumPlayers, RequiredPlayers);
+
+	if (NumPlayers >= RequiredPlayers)
+	{
+		TimerManager.ClearTimer(MinPlayerTimeoutTimerHandle);
+		StartCountdown();
+		return;
+	}
+
+	// A countdown started by the timeout keeps running as long as the minimum is still there
+	if (!bHasMinPlayers)
+	{
+		TimerManager.ClearTimer(MinPlayerTimeoutTimerHandle);
+		CancelCountdown();
+		return;
+	}
+
+	if (!IsCountingDown() && !TimerManager.IsTimerActive(MinPlayerTimeoutTimerHandle))
+	{
+		TimerManager.SetTimer(MinPlayerTimeoutTimerHandle, this, &ThisClass::OnMinPlayerTimeout, FMath::Max(MinPlayerTimeoutInSeconds, KINDA_SMALL_NUMBER), false);
+	}
+}
+
+void UMssLobbyAutoStartComponent::StartCountdown()
+{
+	if (IsCountingDown())
+		return;
+
+	if (CountdownInSeconds <= 0)
+	{
+		StartMatch();
+		return;
+	}
+
+	LOG_INFO(TEXT("Match starts in %d second(s)"), CountdownInSeconds);
+	
+	CountdownSecondsRemaining = CountdownInSeconds;
+	OnLobbyCountdownChanged.Broadcast(CountdownSecondsRemaining);
+	
+	GetWorld()->GetTimerManager().SetTimer(CountdownTimerHandle, this, &ThisClass::TickCountdown, 1.f, true);
+}
+
+void UMssLobbyAutoStartComponent::CancelCountdown()
+{
+	if (!IsCountingDown())
+		return;
+
+	LOG_INFO(TEXT("Countdown cancelled, not enough players"));
+	
+	GetWorld()->GetTimerManager().ClearTimer(CountdownTimerHandle);
+	CountdownSecondsRemaining = 0;
+	OnLobbyCountdownChanged.Broadcast(0);
+}
+
+void UMssLobbyAutoStartComponent::TickCountdown()
+{
+	if (--CountdownSecondsRemaining > 0)
+	{
+		OnLobbyCountdownChanged.Broadcast(CountdownSecondsRemaining);
+		return;
+	}
+
+	GetWorld()->GetTimerManager().ClearTimer(CountdownTimerHandle);
+	
+	StartMatch();
+}
+
+void UMssLobbyAutoStartComponent::OnMinPlayerTimeout()
+{
+	LOG_INFO(TEXT("Lobby did not fill up in %.0fs, starting with the players present"), MinPlayerTimeoutInSeconds);
+	
+	StartCountdown();
+}
+
+void UMssLobbyAutoStartComponent::StartMatch()
+{
+	if (bStartRequested)
+		return;
+
+	CountdownSecondsRemaining = 0;
+
+	// A started session with nowhere to go would strand the lobby, and PreLogin refuses joins once the start is requested
+	FString ResolvedMatchMapPath;
+	if (!ResolveMatchMapPath(ResolvedMatchMapPath))
+	{
+		LOG_ERROR(TEXT("Match not started, no match map to travel to"));
+		return;
+	}
+
+	bStartRequested = true;
+	
+	MssSubsystem->StartSession();
+}
+
+bool UMssLobbyAutoStartComponent::ResolveMatchMapPath(FString& OutMapPath) const
+{
+	FTempCustomSessionSettings HostedSessionSettings;
+	MssSubsystem->GetHostedSessionSettings(HostedSessionSettings);
+
+	for (const FString& Candidate : { MatchMapPath, HostedSessionSettings.MapName })
+	{
+		// Travel options after '?' are kept for the travel but not part of the package name
+		FString PackageName = Candidate;
+		Candidate.Split(TEXT("?"), &PackageName, nullptr);
+
+		if (FPackageName::IsValidLongPackageName(PackageName) && FPackageName::DoesPackageExist(PackageName))
+		{
+			OutMapPath = Candidate;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UMssLobbyAutoStartComponent::OnStartSessionComplete(bool bWasSuccessful)
+{
+	if (!bStartRequested)
+		return;
+
+	if (!bWasSuccessful)
+	{
+		LOG_ERROR(TEXT("Session could not be started, lobby keeps waiting"));
+		
+		bStartRequested = false;
+		EvaluateLobby();
+		return;
+	}
+
+	FString ResolvedMatchMapPath;
+	if (!ResolveMatchMapPath(ResolvedMatchMapPath) || !MssSubsystem->ServerTravelToMap(ResolvedMatchMapPath))
+	{
+		// The session is in progress now so the lobby is not started again, but it takes joins again
+		LOG_ERROR(TEXT("Session started but the travel to the match failed"));
+		bStartRequested = false;
+	}
+}
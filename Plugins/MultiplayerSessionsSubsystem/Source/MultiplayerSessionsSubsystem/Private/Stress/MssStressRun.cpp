@@ -0,0 +1,372 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#include "Stress/MssStressRun.h"
+
+#include "OnlineSessionSettings.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Subsystem/MssSessionListModel.h"
+#include "Subsystem/MssSubsystem.h"
+#include "System/MssLogger.h"
+#include "System/MssSessionRecording.h"
+#include "TimerManager.h"
+
+namespace MssStress
+{
+	/** Seconds between two checks while settling */
+	constexpr float SettlePollIntervalInSeconds = 0.1f;
+
+	/** Searches fired by a FindBurst */
+	constexpr int32 FindBurstSize = 4;
+
+	/** Indexed by EMssTraceOperation */
+	const TCHAR* const TraceOperationNames[] = { TEXT("CreateSession"), TEXT("FindSessions"), TEXT("JoinSession"), TEXT("DestroySession"), TEXT("StartSession") };
+	constexpr int32 NumTraceOperations = UE_ARRAY_COUNT(TraceOperationNames);
+}
+
+bool UMssStressRun::Start(UMssSubsystem* InMssSubsystem, int32 InNumOperations, int32 InSeed)
+{
+	if (bRunning || !InMssSubsystem || !InMssSubsystem->GetGameInstance())
+		return false;
+
+	// Replayed sessions have nothing behind them to host, start or destroy
+	if (InMssSubsystem->IsReplaying())
+	{
+		LOG_WARNING(TEXT("Cannot stress the subsystem while replaying"));
+		return false;
+	}
+
+	MssSubsystem = InMssSubsystem;
+	bRunning = true;
+	bPassed = false;
+	FailureReason.Reset();
+	RecordingPath.Reset();
+	RandomStream.Initialize(InSeed);
+	NumOperationsToFire = FMath::Max(InNumOperations, 1);
+	NumOperationsFired = 0;
+	FiredOperations.Reset();
+	CreateCounter = FMssStressCounter();
+	JoinCounter = FMssStressCounter();
+	StartCounter = FMssStressCounter();
+
+	InMssSubsystem->MultiplayerSessionsOnCreateSessionComplete.AddDynamic(this, &ThisClass::OnCreateSessionComplete);
+	InMssSubsystem->MultiplayerSessionsOnJoinSessionsComplete.AddUObject(this, &ThisClass::OnJoinSessionComplete);
+	InMssSubsystem->MultiplayerSessionsOnStartSessionComplete.AddDynamic(this, &ThisClass::OnStartSessionComplete);
+
+	// LAN discovery is the local backend, no online service is involved
+	bWasLanMode = InMssSubsystem->IsLanMode();
+	InMssSubsystem->SetLanMode(true);
+
+	bOwnsRecording = InMssSubsystem->StartRecording();
+	const FMssSessionRecording* Recording = InMssSubsystem->GetActiveRecording();
+	FirstRecordedOperationIndex = Recording ? Recording->Operations.Num() : 0;
+	NumUnmatchedCompletionsAtStart = Recording ? Recording->NumUnmatchedCompletions : 0;
+
+	LOG_INFO(TEXT("Stress run of %d operation(s), seed %d"), NumOperationsToFire, InSeed);
+
+	FireNextOperation();
+
+	return true;
+}
+
+void UMssStressRun::Abort()
+{
+	if (!bRunning)
+		return;
+
+	LOG_WARNING(TEXT("Stress run interrupted after %d of %d operation(s)"), NumOperationsFired, NumOperationsToFire);
+
+	bRunning = false;
+	bPassed = false;
+	FailureReason = FString::Printf(TEXT("interrupted after %d of %d operation(s)"), NumOperationsFired, NumOperationsToFire);
+
+	RestoreSubsystem();
+}
+
+void UMssStressRun::RestoreSubsystem()
+{
+	UMssSubsystem* Subsystem = MssSubsystem.Get();
+	if (!Subsystem)
+		return;
+
+	Subsystem->MultiplayerSessionsOnCreateSessionComplete.RemoveAll(this);
+	Subsystem->MultiplayerSessionsOnJoinSessionsComplete.RemoveAll(this);
+	Subsystem->MultiplayerSessionsOnStartSessionComplete.RemoveAll(this);
+
+	if (bShowsSessionList)
+	{
+		bShowsSessionList = false;
+		Subsystem->GetSessionListModel()->RemoveConsumer(this);
+	}
+
+	if (const UGameInstance* GameInstance = Subsystem->GetGameInstance())
+	{
+		GameInstance->GetTimerManager().ClearAllTimersForObject(this);
+	}
+
+	if (bOwnsRecording && Subsystem->StopRecording(RecordingPath))
+	{
+		LOG_INFO(TEXT("Stress run recorded to %s"), *RecordingPath);
+	}
+	bOwnsRecording = false;
+
+	Subsystem->SetLanMode(bWasLanMode);
+}
+
+void UMssStressRun::FireNextOperation()
+{
+	FTimerManager& TimerManager = MssSubsystem->GetGameInstance()->GetTimerManager();
+
+	if (NumOperationsFired >= NumOperationsToFire)
+	{
+		// Leaves the subsystem idle, the settle checks expect nothing else to be started
+		if (bShowsSessionList)
+		{
+			bShowsSessionList = false;
+			MssSubsystem->GetSessionListModel()->RemoveConsumer(this);
+		}
+
+		FTempCustomSessionSettings HostedSessionSettings;
+		if (MssSubsystem->GetHostedSessionSettings(HostedSessionSettings))
+		{
+			FireOperation(EMssStressOperation::Destroy);
+		}
+
+		LOG_INFO(TEXT("Fired %d operation(s), settling"), NumOperationsFired);
+
+		SettleStartedAtSeconds = FPlatformTime::Seconds();
+		TimerManager.SetTimer(SettleTimerHandle, this, &ThisClass::Settle, MssStress::SettlePollIntervalInSeconds, true);
+		return;
+	}
+
+	const EMssStressOperation Operation = static_cast<EMssStressOperation>(RandomStream.RandRange(0, static_cast<int32>(EMssStressOperation::ToggleSessionList)));
+	++NumOperationsFired;
+	++FiredOperations.FindOrAdd(Operation);
+
+	FireOperation(Operation);
+
+	const float Interval = RandomStream.FRandRange(0.f, FMath::Max(MaxOperationIntervalInSeconds, 0.f));
+	if (Interval > KINDA_SMALL_NUMBER)
+	{
+		TimerManager.SetTimer(OperationTimerHandle, this, &ThisClass::FireNextOperation, Interval, false);
+	}
+	else
+	{
+		OperationTimerHandle = TimerManager.SetTimerForNextTick(this, &ThisClass::FireNextOperation);
+	}
+}
+
+void UMssStressRun::FireOperation(EMssStressOperation InOperation)
+{
+	switch (InOperation)
+	{
+	case EMssStressOperation::Host:
+		{
+			static const TCHAR* const Players[] = { TEXT("1v1"), TEXT("2v2"), TEXT("4v4") };
+
+			FTempCustomSessionSettings SessionSettings;
+			SessionSettings.MapName = TEXT("Lobby");
+			SessionSettings.GameMode = TEXT("Stress");
+			SessionSettings.Players = Players[RandomStream.RandRange(0, static_cast<int32>(UE_ARRAY_COUNT(Players)) - 1)];
+
+			// Counted first, refused requests are answered before CreateSession returns
+			++CreateCounter.Requested;
+			MssSubsystem->CreateSession(SessionSettings);
+		}
+		break;
+
+	case EMssStressOperation::DoubleHost:
+		FireOperation(EMssStressOperation::Host);
+		FireOperation(EMssStressOperation::Host);
+		break;
+
+	case EMssStressOperation::Find:
+		MssSubsystem->FindSessions();
+		break;
+
+	case EMssStressOperation::FindBurst:
+		for (int32 Index = 0; Index < MssStress::FindBurstSize; ++Index)
+		{
+			MssSubsystem->FindSessions();
+		}
+		break;
+
+	case EMssStressOperation::CancelFind:
+		MssSubsystem->CancelFindSessions();
+		break;
+
+	case EMssStressOperation::Join:
+		{
+			FOnlineSessionSearchResult SessionToJoin;
+			if (!MssSubsystem->GetLowestLatencySearchResult(SessionToJoin))
+			{
+				MssSubsystem->FindSessions();
+				break;
+			}
+
+			++JoinCounter.Requested;
+			MssSubsystem->JoinSessions(SessionToJoin);
+		}
+		break;
+
+	case EMssStressOperation::Destroy:
+		MssSubsystem->DestroySession();
+		break;
+
+	case EMssStressOperation::Start:
+		++StartCounter.Requested;
+		MssSubsystem->StartSession();
+		break;
+
+	case EMssStressOperation::ToggleSessionList:
+		bShowsSessionList = !bShowsSessionList;
+		if (bShowsSessionList)
+		{
+			MssSubsystem->GetSessionListModel()->AddConsumer(this);
+		}
+		else
+		{
+			MssSubsystem->GetSessionListModel()->RemoveConsumer(this);
+		}
+		break;
+	}
+}
+
+bool UMssStressRun::HasSettled() const
+{
+	if (MssSubsystem->IsFindSessionsInProgress() || MssSubsystem->GetNumBoundOperationDelegates() > 0)
+		return false;
+
+	for (const FMssStressCounter* Counter : { &CreateCounter, &JoinCounter, &StartCounter })
+	{
+		if (Counter->Completed < Counter->Requested)
+			return false;
+	}
+
+	const FMssSessionRecording* Recording = MssSubsystem->GetActiveRecording();
+	for (int32 Index = FirstRecordedOperationIndex; Recording && Index < Recording->Operations.Num(); ++Index)
+	{
+		if (Recording->Operations[Index].IsInFlight())
+			return false;
+	}
+
+	return true;
+}
+
+void UMssStressRun::Settle()
+{
+	const bool bSettled = HasSettled();
+	if (!bSettled && FPlatformTime::Seconds() - SettleStartedAtSeconds < SettleTimeoutInSeconds)
+		return;
+
+	MssSubsystem->GetGameInstance()->GetTimerManager().ClearTimer(SettleTimerHandle);
+
+	Finish(bSettled);
+}
+
+void UMssStressRun::Finish(bool bSettled)
+{
+	bRunning = false;
+
+	int32 NumLost = 0;
+	int32 NumDuplicated = 0;
+	int32 NumOverBudget = 0;
+
+	// Answers of the subsystem to the requests of the run
+	auto CheckCounter = [&NumLost, &NumDuplicated](const TCHAR* InName, const FMssStressCounter& InCounter)
+	{
+		LOG_INFO(TEXT("%s : %d requested, %d answered"), InName, InCounter.Requested, InCounter.Completed);
+
+		NumLost += FMath::Max(InCounter.Requested - InCounter.Completed, 0);
+		NumDuplicated += FMath::Max(InCounter.Completed - InCounter.Requested, 0);
+	};
+	CheckCounter(TEXT("Host"), CreateCounter);
+	CheckCounter(TEXT("Join"), JoinCounter);
+	CheckCounter(TEXT("Start"), StartCounter);
+
+	// Completions of the session interface to the operations issued on it
+	if (const FMssSessionRecording* Recording = MssSubsystem->GetActiveRecording())
+	{
+		NumDuplicated += Recording->NumUnmatchedCompletions - NumUnmatchedCompletionsAtStart;
+
+		TArray<double> Durations[MssStress::NumTraceOperations];
+		int32 NumCancelled[MssStress::NumTraceOperations] = {};
+
+		for (int32 Index = FirstRecordedOperationIndex; Index < Recording->Operations.Num(); ++Index)
+		{
+			const FMssRecordedOperation& Operation = Recording->Operations[Index];
+			const int32 OperationIndex = static_cast<int32>(Operation.Operation);
+
+			if (Operation.IsInFlight())
+			{
+				LOG_ERROR(TEXT("%s issued at %.3fs never completed"), MssStress::TraceOperationNames[OperationIndex], Operation.IssuedAtSeconds);
+				++NumLost;
+			}
+			else if (Operation.bWasCancelled)
+			{
+				++NumCancelled[OperationIndex];
+			}
+			else
+			{
+				Durations[OperationIndex].Add(Operation.GetDurationSeconds());
+				NumOverBudget += Operation.GetDurationSeconds() > OperationLatencyBudgetInSeconds ? 1 : 0;
+			}
+		}
+
+		for (int32 OperationIndex = 0; OperationIndex < MssStress::NumTraceOperations; ++OperationIndex)
+		{
+			TArray<double>& OperationDurations = Durations[OperationIndex];
+			if (OperationDurations.IsEmpty())
+				continue;
+
+			OperationDurations.Sort();
+			LOG_INFO(TEXT("%s : %d completed, %d cancelled, median %.1f ms, max %.1f ms"), MssStress::TraceOperationNames[OperationIndex],
+				OperationDurations.Num(), NumCancelled[OperationIndex], OperationDurations[OperationDurations.Num() / 2] * 1000.0, OperationDurations.Last() * 1000.0);
+		}
+	}
+
+	const int32 NumLeakedDelegates = MssSubsystem->GetNumBoundOperationDelegates();
+
+	for (const TPair<EMssStressOperation, int32>& FiredOperation : FiredOperations)
+	{
+		LOG_INFO(TEXT("Fired %s x%d"), *UEnum::GetValueAsString(FiredOperation.Key), FiredOperation.Value);
+	}
+
+	bPassed = bSettled && NumLost == 0 && NumDuplicated == 0 && NumLeakedDelegates == 0 && NumOverBudget == 0;
+	if (bPassed)
+	{
+		LOG_INFO(TEXT("Stress run PASSED, %d operation(s)"), NumOperationsFired);
+	}
+	else
+	{
+		FailureReason = FString::Printf(TEXT("settled %s, %d lost, %d duplicated, %d delegate(s) left bound, %d over the %.1fs budget"),
+			bSettled ? TEXT("yes") : TEXT("no"), NumLost, NumDuplicated, NumLeakedDelegates, NumOverBudget, OperationLatencyBudgetInSeconds);
+		LOG_ERROR(TEXT("Stress run FAILED, %s"), *FailureReason);
+	}
+
+	RestoreSubsystem();
+}
+
+void UMssStressRun::OnCreateSessionComplete(bool bWasSuccessful)
+{
+	if (bRunning)
+	{
+		++CreateCounter.Completed;
+	}
+}
+
+void UMssStressRun::OnJoinSessionComplete(EOnJoinSessionCompleteResult::Type Result)
+{
+	if (bRunning)
+	{
+		++JoinCounter.Completed;
+	}
+}
+
+void UMssStressRun::OnStartSessionComplete(bool bWasSuccessful)
+{
+	if (bRunning)
+	{
+		++StartCounter.Completed;
+	}
+}
@@ -0,0 +1,436 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#include "Subsystem/MssSessionListModel.h"
+
+#include "OnlineSessionSettings.h"
+#include "Online/OnlineSessionNames.h"
+#include "Algo/BinarySearch.h"
+#include "Engine/GameInstance.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "System/MssLogger.h"
+#include "TimerManager.h"
+
+#pragma region Session List Entry
+
+bool FMssSessionSortKey::IsOrderedBefore(const FMssSessionSortKey& Other, EMssSessionSortKey InPrimaryKey) const
+{
+	auto CompareKey = [this, &Other](EMssSessionSortKey InKey) -> int32
+	{
+		switch (InKey)
+		{
+		case EMssSessionSortKey::Ping:	return PingBucket - Other.PingBucket;
+		case EMssSessionSortKey::Fill:	return OpenSlots - Other.OpenSlots;
+		case EMssSessionSortKey::Map:	return MapName.Compare(Other.MapName, ESearchCase::IgnoreCase);
+		case EMssSessionSortKey::Mode:	return GameMode.Compare(Other.GameMode, ESearchCase::IgnoreCase);
+		}
+		return 0;
+	};
+
+	if (const int32 Primary = CompareKey(InPrimaryKey); Primary != 0)
+		return Primary < 0;
+
+	for (const EMssSessionSortKey Key : { EMssSessionSortKey::Ping, EMssSessionSortKey::Fill, EMssSessionSortKey::Map, EMssSessionSortKey::Mode })
+	{
+		if (Key == InPrimaryKey)
+			continue;
+
+		if (const int32 Secondary = CompareKey(Key); Secondary != 0)
+			return Secondary < 0;
+	}
+
+	// Case sensitive, ids differing only in case are different sessions and must not compare equal
+	return SessionId.Compare(Other.SessionId, ESearchCase::CaseSensitive) < 0;
+}
+
+uint32 FMssSessionListEntry::ComputeFingerprint() const
+{
+	// Pings past the query limit are all displayed the same
+	const int32 DisplayedPing = FMath::Min(PingInMs, MAX_QUERY_PING);
+
+	uint32 Hash = GetTypeHash(OpenSlots);
+	Hash = HashCombineFast(Hash, GetTypeHash(DisplayedPing));
+	Hash = HashCombineFast(Hash, GetTypeHash(MapName));
+	Hash = HashCombineFast(Hash, GetTypeHash(GameMode));
+	Hash = HashCombineFast(Hash, GetTypeHash(Players));
+
+	// 0 is reserved for rows that have never been filled
+	return Hash != 0 ? Hash : 1;
+}
+
+#pragma endregion Session List Entry
+
+#pragma region Session List View
+
+void UMssSessionListView::SetFilter(const FTempCustomSessionSettings& InFilter)
+{
+	Filter = InFilter;
+	PageIndex = 0;
+	bSortedEntriesStale = true;
+
+	Refresh();
+}
+
+void UMssSessionListView::SetSortKey(EMssSessionSortKey InSortKey)
+{
+	if (SortKey == InSortKey)
+		return;
+
+	SortKey = InSortKey;
+	bSortedEntriesStale = true;
+
+	Refresh();
+}
+
+void UMssSessionListView::SetPingSortBucketInMs(int32 InPingSortBucketInMs)
+{
+	InPingSortBucketInMs = FMath::Max(InPingSortBucketInMs, 1);
+	if (PingSortBucketInMs == InPingSortBucketInMs)
+		return;
+
+	PingSortBucketInMs = InPingSortBucketInMs;
+	bSortedEntriesStale = true;
+
+	Refresh();
+}
+
+void UMssSessionListView::SetPage(int32 InPageIndex, int32 InPageSize)
+{
+	PageIndex = FMath::Max(InPageIndex, 0);
+	PageSize = FMath::Max(InPageSize, 0);
+
+	Refresh();
+}
+
+int32 UMssSessionListView::GetNumPages() const
+{
+	return PageSize > 0 ? FMath::Max(FMath::DivideAndRoundUp(NumMatchingEntries, PageSize), 1) : 1;
+}
+
+void UMssSessionListView::Refresh()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSessionListView::Refresh);
+
+	if (FilterProvider.IsBound())
+	{
+		const FTempCustomSessionSettings ProvidedFilter = FilterProvider.Execute();
+		if (ProvidedFilter.MapName != Filter.MapName || ProvidedFilter.GameMode != Filter.GameMode || ProvidedFilter.Players != Filter.Players)
+		{
+			Filter = ProvidedFilter;
+			bSortedEntriesStale = true;
+		}
+	}
+
+	static const TArray<FMssSessionListEntry> NoEntries;
+	const UMssSessionListModel* SessionListModel = Model.Get();
+	const TArray<FMssSessionListEntry>& ModelEntries = SessionListModel ? SessionListModel->GetEntries() : NoEntries;
+
+	if (bSortedEntriesStale)
+	{
+		RebuildSortedEntries(ModelEntries);
+	}
+	else
+	{
+		UpdateSortedEntries(ModelEntries);
+	}
+
+	NumMatchingEntries = SortedEntries.Num();
+	PageIndex = FMath::Min(PageIndex, GetNumPages() - 1);
+
+	const int32 FirstIndex = PageSize > 0 ? PageIndex * PageSize : 0;
+	const int32 LastIndex = PageSize > 0 ? FMath::Min(FirstIndex + PageSize, NumMatchingEntries) : NumMatchingEntries;
+
+	bool bRowsChanged = Rows.Num() != LastIndex - FirstIndex;
+
+	TArray<FMssSessionListEntry> NewRows;
+	NewRows.Reserve(LastIndex - FirstIndex);
+
+	for (int32 Index = FirstIndex; Index < LastIndex; ++Index)
+	{
+		const FMssSessionListEntry& Entry = SortedEntries[Index].Entry;
+
+		if (!bRowsChanged)
+		{
+			const FMssSessionListEntry& Row = Rows[NewRows.Num()];
+			bRowsChanged = Row.Fingerprint != Entry.Fingerprint || Row.SessionId != Entry.SessionId;
+		}
+
+		NewRows.Add(Entry);
+	}
+
+	if (!bRowsChanged)
+		return;
+
+	Rows = MoveTemp(NewRows);
+
+	OnViewChanged.Broadcast();
+}
+
+bool UMssSessionListView::MatchesFilter(const FMssSessionListEntry& InEntry) const
+{
+	if (InEntry.OpenSlots <= 0)
+		return false;
+
+	auto Matches = [](const FString& InFilterValue, const FString& InValue)
+	{
+		return InFilterValue.IsEmpty() || InFilterValue == TEXT("Any") || InFilterValue == InValue;
+	};
+
+	return Matches(Filter.MapName, InEntry.MapName) && Matches(Filter.GameMode, InEntry.GameMode) && Matches(Filter.Players, InEntry.Players);
+}
+
+FMssSessionSortKey UMssSessionListView::MakeSortKey(const FMssSessionListEntry& InEntry) const
+{
+	FMssSessionSortKey EntrySortKey;
+	EntrySortKey.PingBucket = InEntry.PingInMs / PingSortBucketInMs;
+	EntrySortKey.OpenSlots = InEntry.OpenSlots;
+	EntrySortKey.MapName = InEntry.MapName;
+	EntrySortKey.GameMode = InEntry.GameMode;
+	EntrySortKey.SessionId = InEntry.SessionId;
+
+	return EntrySortKey;
+}
+
+void UMssSessionListView::RebuildSortedEntries(const TArray<FMssSessionListEntry>& InEntries)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSessionListView::RebuildSortedEntries);
+
+	bSortedEntriesStale = false;
+
+	SortedEntries.Reset(InEntries.Num());
+
+	for (const FMssSessionListEntry& Entry : InEntries)
+	{
+		if (MatchesFilter(Entry))
+		{
+			SortedEntries.Add({ MakeSortKey(Entry), Entry });
+		}
+	}
+
+	SortedEntries.Sort([this](const FMssSortedEntry& A, const FMssSortedEntry& B)
+	{
+		return A.SortKey.IsOrderedBefore(B.SortKey, SortKey);
+	});
+}
+
+void UMssSessionListView::UpdateSortedEntries(const TArray<FMssSessionListEntry>& InEntries)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSessionListView::UpdateSortedEntries);
+
+	TMap<FString, const FMssSessionListEntry*> MatchingEntriesById;
+	MatchingEntriesById.Reserve(InEntries.Num());
+
+	for (const FMssSessionListEntry& Entry : InEntries)
+	{
+		if (MatchesFilter(Entry))
+		{
+			MatchingEntriesById.Add(Entry.SessionId, &Entry);
+		}
+	}
+
+	// Entries that vanished or moved are taken out, the ones left keep their place and only pick up what they display
+	TArray<const FMssSessionListEntry*> EntriesToInsert;
+
+	SortedEntries.RemoveAll([this, &MatchingEntriesById, &EntriesToInsert](FMssSortedEntry& SortedEntry)
+	{
+		const FMssSessionListEntry* ModelEntry = nullptr;
+		if (!MatchingEntriesById.RemoveAndCopyValue(SortedEntry.Entry.SessionId, ModelEntry))
+			return true;
+
+		if (MakeSortKey(*ModelEntry) != SortedEntry.SortKey)
+		{
+			EntriesToInsert.Add(ModelEntry);
+			return true;
+		}
+
+		SortedEntry.Entry = *ModelEntry;
+		return false;
+	});
+
+	for (const TPair<FString, const FMssSessionListEntry*>& NewEntry : MatchingEntriesById)
+	{
+		EntriesToInsert.Add(NewEntry.Value);
+	}
+
+	for (const FMssSessionListEntry* Entry : EntriesToInsert)
+	{
+		FMssSortedEntry SortedEntry{ MakeSortKey(*Entry), *Entry };
+
+		const int32 Index = Algo::LowerBound(SortedEntries, SortedEntry.SortKey, [this](const FMssSortedEntry& Element, const FMssSessionSortKey& Value)
+		{
+			return Element.SortKey.IsOrderedBefore(Value, SortKey);
+		});
+
+		SortedEntries.Insert(MoveTemp(SortedEntry), Index);
+	}
+}
+
+#pragma endregion Session List View
+
+#pragma region Session List Model
+
+void UMssSessionListModel::Initialize(UMssSubsystem* InMssSubsystem)
+{
+	MssSubsystem = InMssSubsystem;
+
+	FindSessionsCompleteDelegateHandle = MssSubsystem->MultiplayerSessionsOnFindSessionsComplete.AddUObject(this, &ThisClass::OnFindSessionsComplete);
+}
+
+void UMssSessionListModel::Deinitialize()
+{
+	if (!MssSubsystem)
+		return;
+
+	MssSubsystem->MultiplayerSessionsOnFindSessionsComplete.Remove(FindSessionsCompleteDelegateHandle);
+
+	if (const UGameInstance* GameInstance = MssSubsystem->GetGameInstance())
+	{
+		GameInstance->GetTimerManager().ClearTimer(PollTimerHandle);
+	}
+
+	Consumers.Empty();
+}
+
+void UMssSessionListModel::AddConsumer(const UObject* InConsumer)
+{
+	const bool bWasPolling = HasConsumers();
+
+	Consumers.AddUnique(InConsumer);
+
+	if (!bWasPolling)
+	{
+		LOG_INFO(TEXT("Session list polling started"));
+		Poll();
+	}
+}
+
+void UMssSessionListModel::RemoveConsumer(const UObject* InConsumer)
+{
+	Consumers.Remove(InConsumer);
+
+	if (HasConsumers() || !MssSubsystem)
+		return;
+
+	LOG_INFO(TEXT("Session list polling stopped"));
+
+	MssSubsystem->GetGameInstance()->GetTimerManager().ClearTimer(PollTimerHandle);
+
+	// Searches started by others, e.g. a join by session code, are left running
+	if (MssSubsystem->IsFindSessionsInProgress() && MssSubsystem->GetSearchGeneration() == PolledSearchGeneration)
+	{
+		MssSubsystem->CancelFindSessions();
+	}
+}
+
+UMssSessionListView* UMssSessionListModel::CreateView()
+{
+	UMssSessionListView* View = NewObject<UMssSessionListView>(this);
+	View->Model = this;
+
+	Views.Add(View);
+
+	View->Refresh();
+
+	return View;
+}
+
+void UMssSessionListModel::Reset()
+{
+	Entries.Empty();
+
+	RefreshViews();
+
+	// The search in flight may have been cancelled along with the backend, restart the loop right away
+	if (MssSubsystem && HasConsumers())
+	{
+		MssSubsystem->GetGameInstance()->GetTimerManager().ClearTimer(PollTimerHandle);
+		Poll();
+	}
+}
+
+bool UMssSessionListModel::HasConsumers()
+{
+	Consumers.RemoveAll([](const TWeakObjectPtr<const UObject>& Consumer) { return !Consumer.IsValid(); });
+
+	return !Consumers.IsEmpty();
+}
+
+void UMssSessionListModel::Poll()
+{
+	if (!MssSubsystem || !HasConsumers())
+		return;
+
+	// Whoever started the search in flight, its results refresh the list too
+	if (MssSubsystem->IsFindSessionsInProgress())
+		return;
+
+	MssSubsystem->FindSessions();
+	PolledSearchGeneration = MssSubsystem->GetSearchGeneration();
+}
+
+void UMssSessionListModel::SchedulePoll(float InDelayInSeconds)
+{
+	if (!MssSubsystem || !HasConsumers())
+		return;
+
+	FTimerManager& TimerManager = MssSubsystem->GetGameInstance()->GetTimerManager();
+
+	if (InDelayInSeconds > 0.f)
+	{
+		TimerManager.SetTimer(PollTimerHandle, this, &ThisClass::Poll, InDelayInSeconds, false);
+	}
+	else
+	{
+		PollTimerHandle = TimerManager.SetTimerForNextTick(this, &ThisClass::Poll);
+	}
+}
+
+void UMssSessionListModel::OnFindSessionsComplete(const TArray<FOnlineSessionSearchResult>& SessionResults, bool bWasSuccessful)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSessionListModel::OnFindSessionsComplete);
+
+	if (!bWasSuccessful)
+	{
+		OnSearchFailed.Broadcast();
+
+		// Do not hammer a backend that is failing
+		SchedulePoll(FMath::Max(PollIntervalInSeconds, 1.f));
+		return;
+	}
+
+	Entries.Reset(SessionResults.Num());
+
+	for (const FOnlineSessionSearchResult& SessionResult : SessionResults)
+	{
+		FMssSessionListEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.SessionId = SessionResult.GetSessionIdStr();
+		Entry.PingInMs = SessionResult.PingInMs;
+		Entry.OpenSlots = SessionResult.Session.NumOpenPublicConnections;
+		SessionResult.Session.SessionSettings.Get(SETTING_MAPNAME, Entry.MapName);
+		SessionResult.Session.SessionSettings.Get(SETTING_GAMEMODE, Entry.GameMode);
+		SessionResult.Session.SessionSettings.Get(SETTING_NUMPLAYERSREQUIRED, Entry.Players);
+		Entry.Fingerprint = Entry.ComputeFingerprint();
+	}
+
+	RefreshViews();
+
+	SchedulePoll(PollIntervalInSeconds);
+}
+
+void UMssSessionListModel::RefreshViews()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSessionListModel::RefreshViews);
+
+	Views.RemoveAll([](const TWeakObjectPtr<UMssSessionListView>& View) { return !View.IsValid(); });
+
+	// A listener may create or drop views while being notified
+	const TArray<TWeakObjectPtr<UMssSessionListView>> ViewsToRefresh = Views;
+	for (const TWeakObjectPtr<UMssSessionListView>& View : ViewsToRefresh)
+	{
+		if (View.IsValid())
+		{
+			View->Refresh();
+		}
+	}
+}
+
+#pragma endregion Session List Model
@@ -0,0 +1,188 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#include "Subsystem/MssSessionResultStore.h"
+
+#include "Online/OnlineSessionNames.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Subsystem/MssSubsystem.h"
+
+int32 FMssSessionResultStore::Project(const TArray<FOnlineSessionSearchResult>& InSearchResults, int64 InBudgetInBytes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FMssSessionResultStore::Project);
+	
+	Reset();
+
+	// Find how many results fit before allocating anything
+	int32 NumToKeep = 0;
+	int64 UsedBytes = 0;
+	for (const FOnlineSessionSearchResult& SearchResult : InSearchResults)
+	{
+		UsedBytes += EstimateEntrySize(SearchResult);
+		if (InBudgetInBytes > 0 && UsedBytes > InBudgetInBytes)
+			break;
+
+		++NumToKeep;
+	}
+
+	SessionIds.Reserve(NumToKeep);
+	SessionKeys.Reserve(NumToKeep);
+	MapNames.Reserve(NumToKeep);
+	GameModes.Reserve(NumToKeep);
+	Players.Reserve(NumToKeep);
+	Regions.Reserve(NumToKeep);
+	Heartbeats.Reserve(NumToKeep);
+	OwningUserNames.Reserve(NumToKeep);
+	PingsInMs.Reserve(NumToKeep);
+	OpenSlots.Reserve(NumToKeep);
+	MaxSlots.Reserve(NumToKeep);
+	BeaconPorts.Reserve(NumToKeep);
+	LanMatches.Reserve(NumToKeep);
+	UsesPresence.Reserve(NumToKeep);
+	AllowJoinInProgress.Reserve(NumToKeep);
+	SessionInfos.Reserve(NumToKeep);
+	OwningUserIds.Reserve(NumToKeep);
+	IndexBySessionId.Reserve(NumToKeep);
+
+	for (int32 Index = 0; Index < NumToKeep; ++Index)
+	{
+		const FOnlineSessionSearchResult& SearchResult = InSearchResults[Index];
+		const FOnlineSessionSettings& SessionSettings = SearchResult.Session.SessionSettings;
+
+		FString MapName, GameMode, NumPlayers, SessionKey, Region;
+		int32 BeaconPort = 0;
+		int64 Heartbeat = 0;
+		SessionSettings.Get(SETTING_MAPNAME, MapName);
+		SessionSettings.Get(SETTING_GAMEMODE, GameMode);
+		SessionSettings.Get(SETTING_NUMPLAYERSREQUIRED, NumPlayers);
+		SessionSettings.Get(SETTING_SESSIONKEY, SessionKey);
+		SessionSettings.Get(SETTING_BEACONPORT, BeaconPort);
+		SessionSettings.Get(SETTING_REGION, Region);
+		SessionSettings.Get(SETTING_HEARTBEAT, Heartbeat);
+
+		const int32 StoreIndex = SessionIds.Add(SearchResult.GetSessionIdStr());
+		SessionKeys.Add(MoveTemp(SessionKey));
+		MapNames.Add(FName(*MapName));
+		GameModes.Add(FName(*GameMode));
+		Players.Add(FName(*NumPlayers));
+		Regions.Add(FName(*Region));
+		Heartbeats.Add(Heartbeat);
+		OwningUserNames.Add(SearchResult.Session.OwningUserName);
+		PingsInMs.Add(SearchResult.PingInMs);
+		OpenSlots.Add(static_cast<int16>(SearchResult.Session.NumOpenPublicConnections));
+		MaxSlots.Add(static_cast<int16>(SessionSettings.NumPublicConnections));
+		BeaconPorts.Add(BeaconPort);
+		LanMatches.Add(SessionSettings.bIsLANMatch);
+		UsesPresence.Add(SessionSettings.bUsesPresence);
+		AllowJoinInProgress.Add(SessionSettings.bAllowJoinInProgress);
+		SessionInfos.Add(SearchResult.Session.SessionInfo);
+		OwningUserIds.Add(SearchResult.Session.OwningUserId);
+		
+		IndexBySessionId.Add(SessionIds[StoreIndex], StoreIndex);
+	}
+
+	return NumToKeep;
+}
+
+void FMssSessionResultStore::Reset()
+{
+	SessionIds.Empty();
+	SessionKeys.Empty();
+	MapNames.Empty();
+	GameModes.Empty();
+	Players.Empty();
+	Regions.Empty();
+	Heartbeats.Empty();
+	OwningUserNames.Empty();
+	PingsInMs.Empty();
+	OpenSlots.Empty();
+	MaxSlots.Empty();
+	BeaconPorts.Empty();
+	LanMatches.Empty();
+	UsesPresence.Empty();
+	AllowJoinInProgress.Empty();
+	SessionInfos.Empty();
+	OwningUserIds.Empty();
+	IndexBySessionId.Empty();
+}
+
+int32 FMssSessionResultStore::FindIndex(const FString& InSessionId) const
+{
+	const int32* Index = IndexBySessionId.Find(InSessionId);
+	
+	return Index ? *Index : INDEX_NONE;
+}
+
+bool FMssSessionResultStore::MakeSearchResult(int32 InIndex, FOnlineSessionSearchResult& OutSearchResult) const
+{
+	if (!SessionIds.IsValidIndex(InIndex))
+		return false;
+
+	OutSearchResult = FOnlineSessionSearchResult();
+	OutSearchResult.PingInMs = PingsInMs[InIndex];
+	OutSearchResult.Session.SessionInfo = SessionInfos[InIndex];
+	OutSearchResult.Session.OwningUserId = OwningUserIds[InIndex];
+	OutSearchResult.Session.OwningUserName = OwningUserNames[InIndex];
+	OutSearchResult.Session.NumOpenPublicConnections = OpenSlots[InIndex];
+
+	FOnlineSessionSettings& SessionSettings = OutSearchResult.Session.SessionSettings;
+	SessionSettings.NumPublicConnections = MaxSlots[InIndex];
+	SessionSettings.bIsLANMatch = LanMatches[InIndex];
+	SessionSettings.bUsesPresence = UsesPresence[InIndex];
+	SessionSettings.bAllowJoinInProgress = AllowJoinInProgress[InIndex];
+	
+	// Every stored result matched the filter seed of the query
+	SessionSettings.Set(SETTING_FILTERSEED, SETTING_FILTERSEED_VALUE, EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	SessionSettings.Set(SETTING_MAPNAME, MapNames[InIndex].ToString(), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	SessionSettings.Set(SETTING_GAMEMODE, GameModes[InIndex].ToString(), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	SessionSettings.Set(SETTING_NUMPLAYERSREQUIRED, Players[InIndex].ToString(), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	SessionSettings.Set(SETTING_SESSIONKEY, SessionKeys[InIndex], EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	
+	if (BeaconPorts[InIndex] > 0)
+	{
+		SessionSettings.Set(SETTING_BEACONPORT, BeaconPorts[InIndex], EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	}
+
+	if (!Regions[InIndex].IsNone())
+	{
+		SessionSettings.Set(SETTING_REGION, Regions[InIndex].ToString(), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	}
+
+	if (Heartbeats[InIndex] > 0)
+	{
+		SessionSettings.Set(SETTING_HEARTBEAT, Heartbeats[InIndex], EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	}
+
+	return true;
+}
+
+int64 FMssSessionResultStore::GetAllocatedSize() const
+{
+	int64 AllocatedSize = SessionIds.GetAllocatedSize() + SessionKeys.GetAllocatedSize()
+		+ MapNames.GetAllocatedSize() + GameModes.GetAllocatedSize() + Players.GetAllocatedSize()
+		+ Regions.GetAllocatedSize() + Heartbeats.GetAllocatedSize() + OwningUserNames.GetAllocatedSize()
+		+ PingsInMs.GetAllocatedSize() + OpenSlots.GetAllocatedSize() + MaxSlots.GetAllocatedSize()
+		+ BeaconPorts.GetAllocatedSize() + LanMatches.GetAllocatedSize()
+		+ UsesPresence.GetAllocatedSize() + AllowJoinInProgress.GetAllocatedSize()
+		+ SessionInfos.GetAllocatedSize() + OwningUserIds.GetAllocatedSize() + IndexBySessionId.GetAllocatedSize();
+
+	// The map keys are copies of the ids
+	for (int32 Index = 0; Index < SessionIds.Num(); ++Index)
+	{
+		AllocatedSize += SessionIds[Index].GetAllocatedSize() * 2 + SessionKeys[Index].GetAllocatedSize() + OwningUserNames[Index].GetAllocatedSize();
+	}
+
+	return AllocatedSize + SessionInfos.Num() * EstimatedSessionInfoBytes;
+}
+
+int64 FMssSessionResultStore::EstimateEntrySize(const FOnlineSessionSearchResult& InSearchResult)
+{
+	// The id is held twice with the index, the session key is counted as long as the id
+	constexpr int64 FixedEntryBytes = sizeof(FString) * 3 + sizeof(FName) * 4 + sizeof(int64) + sizeof(int32) * 2 + sizeof(int16) * 2
+		+ sizeof(TSharedPtr<FOnlineSessionInfo>) + sizeof(FUniqueNetIdPtr) + sizeof(TPair<FString, int32>) + sizeof(FSetElementId) * 2;
+	
+	const int64 SessionIdBytes = (InSearchResult.GetSessionIdStr().Len() + 1) * sizeof(TCHAR);
+	
+	const int64 OwningUserNameBytes = (InSearchResult.Session.OwningUserName.Len() + 1) * sizeof(TCHAR);
+	
+	return FixedEntryBytes + SessionIdBytes * 3 + OwningUserNameBytes + EstimatedSessionInfoBytes;
+}
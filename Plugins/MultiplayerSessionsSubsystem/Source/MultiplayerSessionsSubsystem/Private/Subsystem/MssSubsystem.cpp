@@ -2,37 +2,182 @@
 
 #include "Subsystem/MssSubsystem.h"
 
+#include "OnlineBeaconHost.h"
 #include "OnlineSessionSettings.h"
 #include "OnlineSubsystem.h"
+#include "Beacons/MssBeaconHostObject.h"
+#include "Subsystem/MssSessionListModel.h"
 #include "Online/OnlineSessionNames.h"
 #include "Engine/World.h"
 #include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
 #include "Engine/LocalPlayer.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameMapsSettings.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Internationalization/Culture.h"
+#include "Internationalization/Internationalization.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/PackageName.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "TimerManager.h"
 #include "System/MssLogger.h"
+#include "System/MssTrace.h"
 
 DEFINE_LOG_CATEGORY(MultiplayerSessionSubsystemLog);
 
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GMssStatsCommand(
+	TEXT("mss.stats"),
+	TEXT("Prints the session counters of the plugin. mss.stats dump also writes them to Saved/Mss/"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		UMssSubsystem* MssSubsystem = GameInstance ? GameInstance->GetSubsystem<UMssSubsystem>() : nullptr;
+		if (!MssSubsystem)
+		{
+			Ar.Log(TEXT("mss.stats: no session subsystem in this world"));
+			return;
+		}
+
+		Ar.Log(MssSubsystem->SnapshotStats().ToDisplayString());
+
+		if (Args.Num() > 0 && Args[0] == TEXT("dump"))
+		{
+			MssSubsystem->DumpStats();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GMssRecordCommand(
+	TEXT("mss.record"),
+	TEXT("Records the session backend traffic. mss.record start | stop, the recording is written to Saved/Mss/Recordings/ on stop"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		UMssSubsystem* MssSubsystem = GameInstance ? GameInstance->GetSubsystem<UMssSubsystem>() : nullptr;
+		if (!MssSubsystem)
+		{
+			Ar.Log(TEXT("mss.record: no session subsystem in this world"));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("stop"))
+		{
+			FString RecordingPath;
+			Ar.Log(MssSubsystem->StopRecording(RecordingPath)
+				? FString::Printf(TEXT("mss.record: written to %s"), *RecordingPath)
+				: FString(TEXT("mss.record: nothing recorded")));
+			return;
+		}
+
+		Ar.Log(MssSubsystem->StartRecording() ? TEXT("mss.record: recording") : TEXT("mss.record: already recording or replaying"));
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GMssReplayCommand(
+	TEXT("mss.replay"),
+	TEXT("Answers searches and joins from a recording. mss.replay <file> [time scale] | stop"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		UMssSubsystem* MssSubsystem = GameInstance ? GameInstance->GetSubsystem<UMssSubsystem>() : nullptr;
+		if (!MssSubsystem || Args.IsEmpty())
+		{
+			Ar.Log(TEXT("mss.replay: usage mss.replay <file> [time scale] | stop"));
+			return;
+		}
+
+		if (Args[0] == TEXT("stop"))
+		{
+			MssSubsystem->StopReplay();
+			return;
+		}
+
+		const float TimeScale = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 1.f;
+		Ar.Log(MssSubsystem->StartReplay(Args[0], TimeScale)
+			? FString::Printf(TEXT("mss.replay: replaying %s at %.2fx the recorded timings"), *Args[0], TimeScale)
+			: FString::Printf(TEXT("mss.replay: could not replay %s"), *Args[0]));
+	}));
+
 UMssSubsystem::UMssSubsystem():
 	CreateSessionCompleteDelegate(FOnCreateSessionCompleteDelegate::CreateUObject(this, &ThisClass::OnCreateSessionCompleteCallback)),
 	FindSessionsCompleteDelegate(FOnFindSessionsCompleteDelegate::CreateUObject(this, &ThisClass::OnFindSessionsCompleteCallback)),
+	CancelFindSessionsCompleteDelegate(FOnCancelFindSessionsCompleteDelegate::CreateUObject(this, &ThisClass::OnCancelFindSessionsCompleteCallback)),
 	JoinSessionCompleteDelegate(FOnJoinSessionCompleteDelegate::CreateUObject(this, &ThisClass::OnJoinSessionCompleteCallback)),
 	DestroySessionCompleteDelegate(FOnDestroySessionCompleteDelegate::CreateUObject(this, &ThisClass::OnDestroySessionCompleteCallback)),
-	StartSessionCompleteDelegate(FOnStartSessionCompleteDelegate::CreateUObject(this, &ThisClass::OnStartSessionCompleteCallback))
+	StartSessionCompleteDelegate(FOnStartSessionCompleteDelegate::CreateUObject(this, &ThisClass::OnStartSessionCompleteCallback)),
+	FindFriendSessionCompleteDelegate(FOnFindFriendSessionCompleteDelegate::CreateUObject(this, &ThisClass::OnFindFriendSessionCompleteCallback)),
+	SessionUserInviteAcceptedDelegate(FOnSessionUserInviteAcceptedDelegate::CreateUObject(this, &ThisClass::OnSessionUserInviteAcceptedCallback)),
+	SessionInviteReceivedDelegate(FOnSessionInviteReceivedDelegate::CreateUObject(this, &ThisClass::OnSessionInviteReceivedCallback))
 {
-	const IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
-	if (!OnlineSubsystem)
+}
+
+void UMssSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Acquired here rather than in the constructor so the CDO and builds that never create the subsystem do not touch the online subsystem
+	if (const IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get())
 	{
-		LOG_ERROR(TEXT("UMssSubsystem::UMssSubsystem No Online Subsystem detected! Ensure a valid subsystem is enabled."));
-		return;
+		SessionInterface = OnlineSubsystem->GetSessionInterface();
+		if (!SessionInterface.IsValid())
+		{
+			LOG_ERROR(TEXT("UMssSubsystem::Initialize Online Subsystem does not support sessions!"));
+		}
+	}
+	else
+	{
+		LOG_ERROR(TEXT("UMssSubsystem::Initialize No Online Subsystem detected! Ensure a valid subsystem is enabled."));
 	}
 
-	SessionInterface = OnlineSubsystem->GetSessionInterface();
-	if (!SessionInterface.IsValid())
+	DetectLocalRegion();
+
+	SessionListModel = NewObject<UMssSessionListModel>(this);
+	SessionListModel->Initialize(this);
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("MssLan")))
+	{
+		LOG_INFO(TEXT("-MssLan found on the command line, using LAN sessions"));
+		bUseLanMode = true;
+	}
+
+	FString ReplayPath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("MssReplay="), ReplayPath))
+	{
+		float ReplayTimeScaleParam = 1.f;
+		FParse::Value(FCommandLine::Get(), TEXT("MssReplayTimeScale="), ReplayTimeScaleParam);
+		StartReplay(ReplayPath, ReplayTimeScaleParam);
+	}
+	else if (FParse::Param(FCommandLine::Get(), TEXT("MssRecord")))
+	{
+		StartRecording();
+	}
+
+	FParse::Value(FCommandLine::Get(), TEXT("MssStatsDump="), StatsDumpIntervalInSeconds);
+	if (StatsDumpIntervalInSeconds > 0.f)
+	{
+		GetGameInstance()->GetTimerManager().SetTimer(StatsDumpTimerHandle, this, &ThisClass::DumpStats, StatsDumpIntervalInSeconds, true);
+	}
+
+	PreExitDelegateHandle = FCoreDelegates::OnPreExit.AddUObject(this, &ThisClass::HandleAppExit);
+	PostLoadMapWithWorldDelegateHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::OnPostLoadMapWithWorld);
+
+	if (GEngine)
 	{
-		LOG_ERROR(TEXT("UMssSubsystem::UMssSubsystem Online Subsystem does not support sessions!"));
+		NetworkFailureDelegateHandle = GEngine->OnNetworkFailure().AddUObject(this, &ThisClass::OnNetworkFailure);
 	}
 
-	FCoreDelegates::OnPreExit.AddUObject(this, &UMssSubsystem::HandleAppExit);
+	// Invites and overlay join requests can arrive at any time, not only while a menu is open
+	if (SessionInterface.IsValid())
+	{
+		SessionUserInviteAcceptedDelegateHandle = SessionInterface->AddOnSessionUserInviteAcceptedDelegate_Handle(SessionUserInviteAcceptedDelegate);
+		SessionInviteReceivedDelegateHandle = SessionInterface->AddOnSessionInviteReceivedDelegate_Handle(SessionInviteReceivedDelegate);
+	}
 }
 
 void UMssSubsystem::Deinitialize()
@@ -41,25 +186,148 @@ void UMssSubsystem::Deinitialize()
 	
 	LOG_WARNING(TEXT("UMssSubsystem::Deinitialize called"));
 
-	HandleAppExit();
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapWithWorldDelegateHandle);
+
+	RestoreTransitionMap();
+
+	if (SessionListModel)
+	{
+		SessionListModel->Deinitialize();
+	}
+
+	if (GEngine)
+	{
+		GEngine->OnNetworkFailure().Remove(NetworkFailureDelegateHandle);
+	}
+
+	if (SessionInterface.IsValid())
+	{
+		SessionInterface->ClearOnSessionUserInviteAcceptedDelegate_Handle(SessionUserInviteAcceptedDelegateHandle);
+		SessionInterface->ClearOnSessionInviteReceivedDelegate_Handle(SessionInviteReceivedDelegateHandle);
+		SessionInterface->ClearOnFindFriendSessionCompleteDelegate_Handle(GetLocalUserNum(), FindFriendSessionCompleteDelegateHandle);
+	}
+	
+	ShutdownSessions();
+
+	// The shutdown traffic is part of the recording
+	if (FString RecordingPath; StopRecording(RecordingPath))
+	{
+		LOG_INFO(TEXT("Session recording written to %s"), *RecordingPath);
+	}
+
+	StopReplay();
+
+	if (StatsDumpIntervalInSeconds > 0.f)
+	{
+		GetGameInstance()->GetTimerManager().ClearTimer(StatsDumpTimerHandle);
+		DumpStats();
+	}
 }
 
+#pragma region Shutdown
+
 void UMssSubsystem::HandleAppExit()
 {	
-	LOG_WARNING(TEXT("UMssSubsystem::HandleAppExit - Application exiting, destroying session"));
+	LOG_WARNING(TEXT("UMssSubsystem::HandleAppExit - Application exiting, withdrawing session"));
+
+	ShutdownSessions();
+}
+
+bool UMssSubsystem::ShutdownSessions()
+{
+	if (bHasShutDown)
+		return bAdvertisementWithdrawn;
+
+	bHasShutDown = true;
+	
+	FCoreDelegates::OnPreExit.Remove(PreExitDelegateHandle);
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	
+	if (bFindSessionsInProgress)
+	{
+		CancelFindSessions();
+	}
+	
+	CancelLatencyProbes();
+	DestroyReservationBeaconClient();
+	StopBeaconHost();
+	StopHeartbeat();
+
+	bCreateSessionOnDestroy = false;
+	bJoinSessionOnDestroy = false;
+	bJoinInProgress = false;
+	bTravelOnJoinComplete = false;
+	bAdvertisementWithdrawn = true;
 
 	if (SessionInterface.IsValid() && SessionInterface->GetNamedSession(NAME_GameSession))
 	{
-		LOG_WARNING(TEXT("UMssSubsystem::HandleAppExit Active session detected during shutdown. Destroying..."));
-		DestroySession();
+		LOG_WARNING(TEXT("Active session detected during shutdown. Destroying..."));
+		bAdvertisementWithdrawn = DestroySessionWithinBudget(ShutdownDestroyBudgetInSeconds);
+	}
+
+	const double ElapsedMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+	if (bAdvertisementWithdrawn)
+	{
+		LOG_INFO(TEXT("Shutdown complete in %.1fms, nothing left advertised"), ElapsedMs);
+	}
+	else
+	{
+		LOG_ERROR(TEXT("Shutdown gave up after %.1fms, the session may stay advertised until the backend times it out"), ElapsedMs);
 	}
 	
-	if (bFindSessionsInProgress)
+	return bAdvertisementWithdrawn;
+}
+
+bool UMssSubsystem::DestroySessionWithinBudget(float InTimeBudgetInSeconds)
+{
+	bool bDestroyCompleted = false;
+	bool bDestroySucceeded = false;
+	
+	// Bound for this call only so the regular destroy callback and its create-after-destroy logic stay out of the way
+	const FDelegateHandle ShutdownDestroyDelegateHandle = SessionInterface->AddOnDestroySessionCompleteDelegate_Handle(
+		FOnDestroySessionCompleteDelegate::CreateLambda([&bDestroyCompleted, &bDestroySucceeded](FName SessionName, bool bWasSuccessful)
+		{
+			bDestroyCompleted = true;
+			bDestroySucceeded = bWasSuccessful;
+		}));
+
+	// A destroy already in flight, e.g. from the menu, is refused a second time but its answer reaches this delegate too
+	if (IsSessionInState(EOnlineSessionState::Destroying))
 	{
-		CancelFindSessions();
+		LOG_INFO(TEXT("Session is already being destroyed, waiting for that destruction"));
+	}
+	else if (!SessionInterface->DestroySession(NAME_GameSession))
+	{
+		LOG_ERROR(TEXT("Call to session interface destroy session function failed"));
+		SessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(ShutdownDestroyDelegateHandle);
+		return false;
 	}
+
+	// Nothing ticks the online subsystem while the process is exiting, only it is pumped so no other ticker runs mid teardown
+	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
+	const double DeadlineSeconds = FPlatformTime::Seconds() + InTimeBudgetInSeconds;
+	double LastTickSeconds = FPlatformTime::Seconds();
+	
+	while (!bDestroyCompleted && FPlatformTime::Seconds() < DeadlineSeconds)
+	{
+		const double NowSeconds = FPlatformTime::Seconds();
+		if (OnlineSubsystem)
+		{
+			OnlineSubsystem->Tick(static_cast<float>(NowSeconds - LastTickSeconds));
+		}
+		LastTickSeconds = NowSeconds;
+		
+		FPlatformProcess::Sleep(0.005f);
+	}
+
+	SessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(ShutdownDestroyDelegateHandle);
+	
+	return bDestroyCompleted && bDestroySucceeded;
 }
 
+#pragma endregion Shutdown
+
 #pragma region Session Operations
 
 void UMssSubsystem::CreateSession(const FTempCustomSessionSettings& InCustomSessionSettings)
@@ -72,9 +340,26 @@ void UMssSubsystem::CreateSession(const FTempCustomSessionSettings& InCustomSess
 		MultiplayerSessionsOnCreateSessionComplete.Broadcast(false);
 		return;
 	}
+
+	if (bHasShutDown)
+	{
+		LOG_WARNING(TEXT("CreateSession ignored, subsystem has shut down"));
+		MultiplayerSessionsOnCreateSessionComplete.Broadcast(false);
+		return;
+	}
 	
 	if (SessionInterface->GetNamedSession(NAME_GameSession))
-	{		
+	{
+		// A session still being created or torn down cannot be destroyed yet, e.g. a double clicked host button
+		if (bCreateSessionOnDestroy || (!IsSessionInState(EOnlineSessionState::Pending) &&
+			!IsSessionInState(EOnlineSessionState::InProgress) &&
+			!IsSessionInState(EOnlineSessionState::Ended)))
+		{
+			LOG_ERROR(TEXT("CreateSession blocked: session busy"));
+			MultiplayerSessionsOnCreateSessionComplete.Broadcast(false);
+			return;
+		}
+		
 		LOG_ERROR(TEXT("NAME_GameSession already exists, destroying before creating a new one"));
 		
 		bCreateSessionOnDestroy = true;
@@ -87,28 +372,37 @@ void UMssSubsystem::CreateSession(const FTempCustomSessionSettings& InCustomSess
 
 	CreateSessionCompleteDelegateHandle = SessionInterface->AddOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegate);
 
-	int32 NumPublicConnections = 2;
-	if (InCustomSessionSettings.Players == "2v2") NumPublicConnections = 4;
-	else if (InCustomSessionSettings.Players == "4v4") NumPublicConnections = 8;
+	const int32 NumPublicConnections = GetRequiredPlayerCount(InCustomSessionSettings.Players);
 	
 	const TSharedPtr<FOnlineSessionSettings> OnlineSessionSettings = MakeShareable(new FOnlineSessionSettings());
-	OnlineSessionSettings->bIsLANMatch = false;
+	OnlineSessionSettings->bIsLANMatch = bUseLanMode;
 	OnlineSessionSettings->NumPublicConnections = NumPublicConnections;
 	OnlineSessionSettings->bAllowJoinInProgress = true;
 	OnlineSessionSettings->bAllowJoinViaPresence = true;
 	OnlineSessionSettings->bShouldAdvertise = true;
 	OnlineSessionSettings->bUsesPresence = true;
-	OnlineSessionSettings->bUseLobbiesIfAvailable = true;
+	OnlineSessionSettings->bUseLobbiesIfAvailable = !bUseLanMode;
 	OnlineSessionSettings->Set(SETTING_FILTERSEED, SETTING_FILTERSEED_VALUE, EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
 	OnlineSessionSettings->Set(SETTING_MAPNAME, InCustomSessionSettings.MapName, EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
 	OnlineSessionSettings->Set(SETTING_GAMEMODE, InCustomSessionSettings.GameMode, EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
 	OnlineSessionSettings->Set(SETTING_NUMPLAYERSREQUIRED, InCustomSessionSettings.Players, EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
 	OnlineSessionSettings->Set(SETTING_SESSIONKEY, GenerateSessionUniqueCode(), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	OnlineSessionSettings->Set(SETTING_HEARTBEAT, GetHeartbeatTimestamp(), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+
+	OnlineSessionSettings->Set(SETTING_REGION, GetLocalRegion().IsEmpty() ? FString(SETTING_REGION_GLOBAL) : GetLocalRegion(), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
 
+	// SETTING_BEACONPORT is advertised once the beacon host listens, see StartBeaconHost
+
+	CreateSessionTraceId = MssTrace::BeginOperation(EMssTraceOperation::CreateSession);
+	RecordOperationIssued(EMssTraceOperation::CreateSession);
+	
 	if (!SessionInterface->CreateSession(*GetWorld()->GetFirstLocalPlayerFromController()->GetPreferredUniqueNetId(), NAME_GameSession, *OnlineSessionSettings))
 	{
 		LOG_ERROR(TEXT("CreateSession failed to execute create session"));
 
+		MssTrace::EndOperation(EMssTraceOperation::CreateSession, CreateSessionTraceId, false);
+		RecordOperationCompleted(EMssTraceOperation::CreateSession, false);
+
 		SessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegateHandle);
 		MultiplayerSessionsOnCreateSessionComplete.Broadcast(false);
 	}
@@ -121,40 +415,119 @@ void UMssSubsystem::FindSessions()
 	if (!SessionInterface.IsValid())
 	{
 		LOG_ERROR(TEXT("FindSessions SessionInterface is INVALID"));
-		MultiplayerSessionsOnFindSessionsComplete.Broadcast(TArray<FOnlineSessionSearchResult>(), false);
+		BroadcastNoSearchResults(false);
+		return;
+	}
+
+	if (bHasShutDown)
+	{
+		LOG_WARNING(TEXT("FindSessions ignored, subsystem has shut down"));
+		BroadcastNoSearchResults(false);
 		return;
 	}
 	
-	if (bFindSessionsInProgress)
+	if (!GetWorld() || GetWorld()->bIsTearingDown)
+	{
+		LOG_WARNING(TEXT("FindSessions aborted – world is tearing down"));
+		BroadcastNoSearchResults(false);
+		return;
+	}
+	
+	if (bFindSessionsInProgress || !ActiveLatencyProbes.IsEmpty())
 	{
 		LOG_INFO(TEXT("Find session already in progress calling to cancel search"));
 		CancelFindSessions();
 	}
-	
+
+	++SearchGeneration;
+
+	// LAN discovery only reaches the local network, regions do not apply there
+	PendingSearchRegions.Reset();
+	RegionSearchResults.Reset();
+	if (!bUseLanMode)
+	{
+		GetSearchRegions(PendingSearchRegions);
+	}
+
+	IssueFindSessions();
+}
+
+void UMssSubsystem::IssueFindSessions()
+{
 	bFindSessionsInProgress = true;
 	
-	FindSessionsCompleteDelegateHandle = SessionInterface->AddOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegate);
+	const uint32 Generation = SearchGeneration;
 	
 	LastCreatedSessionSearch = MakeShareable(new FOnlineSessionSearch());
-	LastCreatedSessionSearch->MaxSearchResults = 10000;
-	LastCreatedSessionSearch->bIsLanQuery = false;
 	LastCreatedSessionSearch->QuerySettings.Set(SETTING_FILTERSEED, SETTING_FILTERSEED_VALUE, EOnlineComparisonOp::Equals);
-	LastCreatedSessionSearch->QuerySettings.Set(SEARCH_LOBBIES, true, EOnlineComparisonOp::Equals);
+	
+	if (bUseLanMode)
+	{
+		LastCreatedSessionSearch->MaxSearchResults = LanMaxSearchResults;
+		LastCreatedSessionSearch->bIsLanQuery = true;
+		LastCreatedSessionSearch->TimeoutInSeconds = LanSearchTimeoutInSeconds;
+	}
+	else
+	{
+		LastCreatedSessionSearch->MaxSearchResults = 10000;
+		LastCreatedSessionSearch->bIsLanQuery = false;
+		LastCreatedSessionSearch->QuerySettings.Set(SEARCH_LOBBIES, true, EOnlineComparisonOp::Equals);
 
-	if (!GetWorld() || GetWorld()->bIsTearingDown)
+		if (!PendingSearchRegions.IsEmpty())
+		{
+			const FString SearchRegion = PendingSearchRegions[0];
+			PendingSearchRegions.RemoveAt(0);
+
+			if (SearchRegion.IsEmpty())
+			{
+				LOG_INFO(TEXT("Searching sessions in every region"));
+			}
+			else
+			{
+				LOG_INFO(TEXT("Searching sessions in region %s"), *SearchRegion);
+				LastCreatedSessionSearch->QuerySettings.Set(SETTING_REGION, SearchRegion, EOnlineComparisonOp::Equals);
+			}
+		}
+	}
+
+	FindSessionsTraceId = MssTrace::BeginOperation(EMssTraceOperation::FindSessions);
+	RecordOperationIssued(EMssTraceOperation::FindSessions);
+
+	if (IsReplaying())
 	{
-		LOG_WARNING(TEXT("FindSessions aborted – world is tearing down"));
-		MultiplayerSessionsOnFindSessionsComplete.Broadcast(TArray<FOnlineSessionSearchResult>(), false);
+		++Stats.SearchesIssued;
+		ReplayFindSessions(Generation);
 		return;
 	}
 
+	FindSessionsCompleteDelegateHandle = SessionInterface->AddOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegate);
+	
 	if (!SessionInterface->FindSessions(*GetWorld()->GetFirstLocalPlayerFromController()->GetPreferredUniqueNetId(), LastCreatedSessionSearch.ToSharedRef()))
 	{
 		LOG_ERROR(TEXT("Call to session interface find sessions function failed"));
 		
+		MssTrace::EndOperation(EMssTraceOperation::FindSessions, FindSessionsTraceId, false);
+
+		// A widened search still reports what the regions searched before have found
+		if (!RegionSearchResults.IsEmpty())
+		{
+			PendingSearchRegions.Reset();
+			CompleteFindSessions(true);
+			return;
+		}
+		
+		RecordOperationCompleted(EMssTraceOperation::FindSessions, false);
 		SessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
 		bFindSessionsInProgress = false;
-		MultiplayerSessionsOnFindSessionsComplete.Broadcast(TArray<FOnlineSessionSearchResult>(), false);
+		BroadcastNoSearchResults(false);
+		return;
+	}
+
+	++Stats.SearchesIssued;
+
+	if (bUseLanMode)
+	{
+		GetGameInstance()->GetTimerManager().SetTimer(LanSearchTimeoutTimerHandle, this, &ThisClass::OnLanSearchTimedOut, LanSearchTimeoutInSeconds, false);
 	}
 }
 
@@ -168,15 +541,49 @@ void UMssSubsystem::CancelFindSessions()
 		return;
 	}
 
+	// Anything still arriving for the current search is stale from here on
+	++SearchGeneration;
+	
+	GetGameInstance()->GetTimerManager().ClearTimer(LanSearchTimeoutTimerHandle);
+	GetGameInstance()->GetTimerManager().ClearTimer(ReplayFindSessionsTimerHandle);
+	CancelLatencyProbes();
+
+	if (!bFindSessionsInProgress)
+		return;
+	
 	bFindSessionsInProgress = false;
 	
 	LOG_WARNING(TEXT("Aborting search"));
 
+	MssTrace::EndOperation(EMssTraceOperation::FindSessions, FindSessionsTraceId, false);
+	RecordOperationCancelled(EMssTraceOperation::FindSessions);
+
+	// Nothing in flight on the session interface
+	if (IsReplaying())
+		return;
+
 	SessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
-	MultiplayerSessionsOnFindSessionsComplete.Broadcast(TArray<FOnlineSessionSearchResult>(), true);
+
+	if (!CancelFindSessionsCompleteDelegateHandle.IsValid())
+	{
+		CancelFindSessionsCompleteDelegateHandle = SessionInterface->AddOnCancelFindSessionsCompleteDelegate_Handle(CancelFindSessionsCompleteDelegate);
+	}
+	
+	if (!SessionInterface->CancelFindSessions())
+	{
+		LOG_WARNING(TEXT("Session interface could not cancel the search, its results will be dropped"));
+		
+		SessionInterface->ClearOnCancelFindSessionsCompleteDelegate_Handle(CancelFindSessionsCompleteDelegateHandle);
+		CancelFindSessionsCompleteDelegateHandle.Reset();
+	}
+}
+
+void UMssSubsystem::JoinSessions(FOnlineSessionSearchResult& InSessionToJoin, int32 InPartySize)
+{
+	RequestJoinSession(InSessionToJoin, InPartySize, false);
 }
 
-void UMssSubsystem::JoinSessions(FOnlineSessionSearchResult& InSessionToJoin)
+void UMssSubsystem::RequestJoinSession(FOnlineSessionSearchResult& InSessionToJoin, int32 InPartySize, bool bInTravelOnComplete)
 {
 	LOG_INFO(TEXT("Called"));
 	
@@ -186,6 +593,13 @@ void UMssSubsystem::JoinSessions(FOnlineSessionSearchResult& InSessionToJoin)
 		MultiplayerSessionsOnJoinSessionsComplete.Broadcast(EOnJoinSessionCompleteResult::UnknownError);
 		return;
 	}
+
+	if (bHasShutDown)
+	{
+		LOG_WARNING(TEXT("JoinSession ignored, subsystem has shut down"));
+		MultiplayerSessionsOnJoinSessionsComplete.Broadcast(EOnJoinSessionCompleteResult::UnknownError);
+		return;
+	}
 	
 	if (IsSessionInState(EOnlineSessionState::Creating) ||
 		IsSessionInState(EOnlineSessionState::Starting) ||
@@ -196,16 +610,66 @@ void UMssSubsystem::JoinSessions(FOnlineSessionSearchResult& InSessionToJoin)
 		return;
 	}
 
+	// A second join would overwrite the interface delegate handle of the first, e.g. a spammed join by code button
+	if (bJoinInProgress)
+	{
+		LOG_ERROR(TEXT("JoinSession blocked: a join is already in flight"));
+		MultiplayerSessionsOnJoinSessionsComplete.Broadcast(EOnJoinSessionCompleteResult::UnknownError);
+		return;
+	}
+
+	// The backend would only refuse again, answer with the reason it gave last time
+	EOnJoinSessionCompleteResult::Type FailedJoinResult;
+	if (GetFailedJoin(InSessionToJoin.GetSessionIdStr(), FailedJoinResult))
+	{
+		LOG_WARNING(TEXT("JoinSession skipped, the last join of %s failed with %s"), *InSessionToJoin.GetSessionIdStr(), LexToString(FailedJoinResult));
+		MultiplayerSessionsOnJoinSessionsComplete.Broadcast(FailedJoinResult);
+		return;
+	}
+
+	// Only set once the join is issued, a refused join must not make the join in flight travel
+	bJoinInProgress = true;
+	bTravelOnJoinComplete = bInTravelOnComplete;
+	
+	++Stats.JoinsAttempted;
+	JoinRequestedAtSeconds = FPlatformTime::Seconds();
+	PendingJoinSessionId = InSessionToJoin.GetSessionIdStr();
+
+	// Covers the reservation round trip as well, that is part of what the player waits for
+	JoinSessionTraceId = MssTrace::BeginOperation(EMssTraceOperation::JoinSession);
+	RecordOperationIssued(EMssTraceOperation::JoinSession, PendingJoinSessionId);
+
+	// Replayed sessions have no host to reserve slots on
+	if (bUseJoinReservations && !IsReplaying() && RequestJoinReservation(InSessionToJoin, InPartySize))
+	{
+		return;
+	}
+
+	JoinSessionInternal(InSessionToJoin);
+}
+
+void UMssSubsystem::JoinSessionInternal(FOnlineSessionSearchResult& InSessionToJoin)
+{
+	if (IsReplaying())
+	{
+		ReplayJoinSession(InSessionToJoin.GetSessionIdStr());
+		return;
+	}
+	
 	JoinSessionCompleteDelegateHandle = SessionInterface->AddOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegate);
 
-	InSessionToJoin.Session.SessionSettings.bUseLobbiesIfAvailable = true;
+	InSessionToJoin.Session.SessionSettings.bUseLobbiesIfAvailable = !bUseLanMode;
 	InSessionToJoin.Session.SessionSettings.bUsesPresence = true;
 	
 	if (!SessionInterface->JoinSession(*GetWorld()->GetFirstLocalPlayerFromController()->GetPreferredUniqueNetId(), NAME_GameSession, InSessionToJoin))
 	{
 		LOG_ERROR(TEXT("Call to session interface join session function failed"));
 		
+		MssTrace::EndOperation(EMssTraceOperation::JoinSession, JoinSessionTraceId, false);
+		RecordOperationCompleted(EMssTraceOperation::JoinSession, false, EOnJoinSessionCompleteResult::UnknownError);
 		SessionInterface->ClearOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegateHandle);
+		bJoinInProgress = false;
+		bTravelOnJoinComplete = false;
 		MultiplayerSessionsOnJoinSessionsComplete.Broadcast(EOnJoinSessionCompleteResult::UnknownError);
 	}
 }
@@ -231,12 +695,18 @@ void UMssSubsystem::DestroySession()
 	}
 
 	DestroySessionCompleteDelegateHandle = SessionInterface->AddOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegate);
+	DestroySessionTraceId = MssTrace::BeginOperation(EMssTraceOperation::DestroySession);
+	RecordOperationIssued(EMssTraceOperation::DestroySession);
 
 	if (!SessionInterface->DestroySession(NAME_GameSession))
 	{
 		LOG_ERROR(TEXT("Call to session interface destroy session function failed"));
 
+		MssTrace::EndOperation(EMssTraceOperation::DestroySession, DestroySessionTraceId, false);
+		RecordOperationCompleted(EMssTraceOperation::DestroySession, false);
+
 		SessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegateHandle);
+		FailCreateSessionOnDestroy();
 		MultiplayerSessionsOnDestroySessionComplete.Broadcast(false);
 	}
 }
@@ -260,11 +730,16 @@ void UMssSubsystem::StartSession()
 	}
 
 	StartSessionCompleteDelegateHandle = SessionInterface->AddOnStartSessionCompleteDelegate_Handle(StartSessionCompleteDelegate);
+	StartSessionTraceId = MssTrace::BeginOperation(EMssTraceOperation::StartSession);
+	RecordOperationIssued(EMssTraceOperation::StartSession);
 
 	if (!SessionInterface->StartSession(NAME_GameSession))
 	{
 		LOG_ERROR(TEXT("Call to session interface start session function failed"));
 
+		MssTrace::EndOperation(EMssTraceOperation::StartSession, StartSessionTraceId, false);
+		RecordOperationCompleted(EMssTraceOperation::StartSession, false);
+
 		SessionInterface->ClearOnStartSessionCompleteDelegate_Handle(StartSessionCompleteDelegateHandle);
 		MultiplayerSessionsOnStartSessionComplete.Broadcast(false);
 	}
@@ -272,67 +747,1580 @@ void UMssSubsystem::StartSession()
 
 #pragma endregion Session Operations
 
-FString UMssSubsystem::GenerateSessionUniqueCode() const
-{
-	const FDateTime CurrentTime = FDateTime::Now();
-	const FString SumOfCurrentTime = FString::Printf(TEXT("%d%d%03d"), CurrentTime.GetMinute(), CurrentTime.GetSecond(), CurrentTime.GetMillisecond());
+#pragma region LAN Mode
 
-	LOG_INFO(TEXT("Generated session code '%s'"), *SumOfCurrentTime);
+void UMssSubsystem::SetLanMode(bool bInUseLanMode)
+{
+	LOG_INFO(TEXT("LAN mode : %s"), bInUseLanMode ? TEXT("enabled") : TEXT("disabled"));
+	
+	if (bInUseLanMode == bUseLanMode)
+		return;
+	
+	if (bFindSessionsInProgress)
+	{
+		CancelFindSessions();
+	}
+	
+	bUseLanMode = bInUseLanMode;
 
-	return SumOfCurrentTime;
+	// Sessions of the other backend are not joinable anymore
+	if (SessionListModel)
+	{
+		SessionListModel->Reset();
+	}
 }
 
-#pragma region Session Operations On Completion Delegates Callbacks
-	
-void UMssSubsystem::OnCreateSessionCompleteCallback(FName SessionName, bool bWasSuccessful)
+void UMssSubsystem::OnLanSearchTimedOut()
 {
-	LOG_INFO(TEXT("Created session : %s"), bWasSuccessful ? TEXT("success") : TEXT("failed"));
-
-	if (SessionInterface)
-		SessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegateHandle); 
+	if (!bFindSessionsInProgress)
+		return;
+	
+	LOG_INFO(TEXT("LAN discovery window of %.2fs closed, completing with the replies received so far"), LanSearchTimeoutInSeconds);
 
-	if (const FNamedOnlineSession* Session = SessionInterface->GetNamedSession(NAME_GameSession); bWasSuccessful)
+	if (SessionInterface.IsValid())
 	{
-		FString SessionCode;
-		Session->SessionSettings.Get(SETTING_SESSIONKEY, SessionCode);
-		// Display session key
+		SessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
+		SessionInterface->CancelFindSessions();
 	}
-	
-	MultiplayerSessionsOnCreateSessionComplete.Broadcast(bWasSuccessful);	
+
+	CompleteFindSessions(true);
 }
 
-void UMssSubsystem::OnFindSessionsCompleteCallback(bool bWasSuccessful)
+void UMssSubsystem::FilterLanSearchResults(TArray<FOnlineSessionSearchResult>& SearchResults)
 {
-	LOG_INFO(TEXT("Found sessions : %s"), bWasSuccessful ? TEXT("success") : TEXT("failed"));
-
-	bFindSessionsInProgress = false;
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSubsystem::FilterLanSearchResults);
 	
-	if (SessionInterface)
+	SearchResults.RemoveAll([](const FOnlineSessionSearchResult& SearchResult)
 	{
-		SessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
-	}
+		int32 FilterSeed = 0;
+		return !SearchResult.Session.SessionSettings.Get(SETTING_FILTERSEED, FilterSeed) || FilterSeed != SETTING_FILTERSEED_VALUE;
+	});
+}
 
-	if (!LastCreatedSessionSearch.IsValid())
+#pragma endregion LAN Mode
+
+#pragma region Join Reservations
+
+bool UMssSubsystem::RequestJoinReservation(const FOnlineSessionSearchResult& InSessionToJoin, int32 InPartySize)
+{
+	int32 BeaconPort = 0;
+	if (!InSessionToJoin.Session.SessionSettings.Get(SETTING_BEACONPORT, BeaconPort))
 	{
-		LOG_ERROR(TEXT("LastCreatedSessionSearch is Invalid"));
-		MultiplayerSessionsOnFindSessionsComplete.Broadcast(TArray<FOnlineSessionSearchResult>(), bWasSuccessful);
-		return;
+		LOG_INFO(TEXT("Host does not advertise a reservation beacon, joining directly"));
+		return false;
 	}
-		
-	if (LastCreatedSessionSearch->SearchResults.IsEmpty())
+
+	FString BeaconConnectInfo;
+	if (!SessionInterface->GetResolvedConnectString(InSessionToJoin, NAME_BeaconPort, BeaconConnectInfo))
 	{
-		LOG_WARNING(TEXT("Search result is empty no session found"));
-		MultiplayerSessionsOnFindSessionsComplete.Broadcast(TArray<FOnlineSessionSearchResult>(), bWasSuccessful);
-		return;
+		LOG_WARNING(TEXT("Failed to resolve the beacon address of the host, joining directly"));
+		return false;
 	}
 
-	MultiplayerSessionsOnFindSessionsComplete.Broadcast(LastCreatedSessionSearch->SearchResults, bWasSuccessful);
-}
+	UWorld* World = GetWorld();
+	if (!World)
+		return false;
 
-void UMssSubsystem::OnJoinSessionCompleteCallback(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
-{
-	switch (Result)
-	{
+	// Only one request in flight, a new join request replaces the previous one
+	DestroyReservationBeaconClient();
+
+	FString SessionKey;
+	InSessionToJoin.Session.SessionSettings.Get(SETTING_SESSIONKEY, SessionKey);
+	
+	ReservationBeaconClient = World->SpawnActor<AMssBeaconClient>(AMssBeaconClient::StaticClass());
+	if (!ReservationBeaconClient)
+	{
+		LOG_ERROR(TEXT("Failed to spawn the reservation beacon"));
+		return false;
+	}
+	
+	ReservationBeaconClient->OnReservationResponse.BindUObject(this, &ThisClass::OnReservationResponse, TWeakObjectPtr<AMssBeaconClient>(ReservationBeaconClient));
+	PendingReservationSearchResult = InSessionToJoin;
+	
+	if (!ReservationBeaconClient->RequestReservation(BeaconConnectInfo, SessionKey, 
+		World->GetFirstLocalPlayerFromController()->GetPreferredUniqueNetId(), InPartySize))
+	{
+		DestroyReservationBeaconClient();
+		return false;
+	}
+
+	GetGameInstance()->GetTimerManager().SetTimer(ReservationRequestTimeoutTimerHandle, this, &ThisClass::OnReservationRequestTimedOut, ReservationRequestTimeoutInSeconds, false);
+	
+	return true;
+}
+
+void UMssSubsystem::OnReservationResponse(EMssReservationResult Result, TWeakObjectPtr<AMssBeaconClient> InBeaconClient)
+{
+	// The request has already been answered or timed out, or replaced by a newer one
+	if (!ReservationBeaconClient || InBeaconClient.Get() != ReservationBeaconClient)
+		return;
+	
+	GetGameInstance()->GetTimerManager().ClearTimer(ReservationRequestTimeoutTimerHandle);
+	DestroyReservationBeaconClient();
+
+	switch (Result)
+	{
+	case EMssReservationResult::Accepted:
+		LOG_INFO(TEXT("Reservation accepted, joining session"));
+		JoinSessionInternal(PendingReservationSearchResult);
+		break;
+	case EMssReservationResult::SessionFull:
+		LOG_WARNING(TEXT("Reservation rejected, session is full"));
+		RecordFailedJoin(PendingJoinSessionId, EOnJoinSessionCompleteResult::SessionIsFull);
+		ReleasePreloadedMap();
+		MssTrace::EndOperation(EMssTraceOperation::JoinSession, JoinSessionTraceId, false);
+		RecordOperationCompleted(EMssTraceOperation::JoinSession, false, EOnJoinSessionCompleteResult::SessionIsFull);
+		bJoinInProgress = false;
+		bTravelOnJoinComplete = false;
+		MultiplayerSessionsOnJoinSessionsComplete.Broadcast(EOnJoinSessionCompleteResult::SessionIsFull);
+		break;
+	case EMssReservationResult::SessionMismatch:
+		LOG_WARNING(TEXT("Reservation rejected, host is not running the requested session"));
+		RecordFailedJoin(PendingJoinSessionId, EOnJoinSessionCompleteResult::SessionDoesNotExist);
+		ReleasePreloadedMap();
+		MssTrace::EndOperation(EMssTraceOperation::JoinSession, JoinSessionTraceId, false);
+		RecordOperationCompleted(EMssTraceOperation::JoinSession, false, EOnJoinSessionCompleteResult::SessionDoesNotExist);
+		bJoinInProgress = false;
+		bTravelOnJoinComplete = false;
+		MultiplayerSessionsOnJoinSessionsComplete.Broadcast(EOnJoinSessionCompleteResult::SessionDoesNotExist);
+		break;
+	case EMssReservationResult::TimedOut:
+	case EMssReservationResult::ConnectionFailed:
+		// The beacon may be blocked while the session itself is reachable through the backend, so fall back to a plain join
+		LOG_WARNING(TEXT("No reservation answer from the host (%s), joining directly"), *UEnum::GetValueAsString(Result));
+		JoinSessionInternal(PendingReservationSearchResult);
+		break;
+	}
+}
+
+void UMssSubsystem::OnReservationRequestTimedOut()
+{
+	OnReservationResponse(EMssReservationResult::TimedOut, ReservationBeaconClient);
+}
+
+void UMssSubsystem::DestroyReservationBeaconClient()
+{
+	if (!ReservationBeaconClient)
+		return;
+
+	ReservationBeaconClient->OnReservationResponse.Unbind();
+	DestroyBeaconClientNextTick(ReservationBeaconClient);
+	ReservationBeaconClient = nullptr;
+}
+
+void UMssSubsystem::DestroyBeaconClientNextTick(AMssBeaconClient* InBeaconClient) const
+{
+	const UGameInstance* GameInstance = GetGameInstance();
+	if (!IsValid(InBeaconClient) || !GameInstance)
+		return;
+	
+	TWeakObjectPtr<AMssBeaconClient> WeakBeaconClient = InBeaconClient;
+	GameInstance->GetTimerManager().SetTimerForNextTick([WeakBeaconClient]()
+	{
+		if (AMssBeaconClient* BeaconClient = WeakBeaconClient.Get())
+		{
+			BeaconClient->DestroyBeacon();
+		}
+	});
+}
+
+void UMssSubsystem::StartBeaconHost(UWorld* InWorld)
+{
+	if (IsValid(BeaconHost) && BeaconHost->GetWorld() == InWorld)
+		return;
+
+	StopBeaconHost();
+
+	BeaconHost = InWorld->SpawnActor<AOnlineBeaconHost>(AOnlineBeaconHost::StaticClass());
+	if (!BeaconHost || !BeaconHost->InitHost())
+	{
+		LOG_ERROR(TEXT("Failed to start the reservation beacon host"));
+		StopBeaconHost();
+		return;
+	}
+
+	BeaconHostObject = InWorld->SpawnActor<AMssBeaconHostObject>(AMssBeaconHostObject::StaticClass());
+	BeaconHost->RegisterHost(BeaconHostObject);
+	BeaconHost->PauseBeaconRequests(false);
+
+	LOG_INFO(TEXT("Reservation beacon listening on port %d"), BeaconHost->GetListenPort());
+
+	// Clients resolve the beacon address from the session, advertise the port actually bound rather than the configured one
+	const FNamedOnlineSession* Session = SessionInterface.IsValid() ? SessionInterface->GetNamedSession(NAME_GameSession) : nullptr;
+	if (!Session)
+		return;
+
+	FOnlineSessionSettings UpdatedSessionSettings = Session->SessionSettings;
+	UpdatedSessionSettings.Set(SETTING_BEACONPORT, BeaconHost->GetListenPort(), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+
+	if (!SessionInterface->UpdateSession(NAME_GameSession, UpdatedSessionSettings, true))
+	{
+		LOG_WARNING(TEXT("Reservation beacon port could not be advertised, clients will join directly"));
+	}
+}
+
+void UMssSubsystem::StopBeaconHost()
+{
+	if (IsValid(BeaconHost))
+	{
+		if (IsValid(BeaconHostObject))
+		{
+			BeaconHost->UnregisterHost(BeaconHostObject->GetBeaconType());
+		}
+		
+		BeaconHost->DestroyBeacon();
+	}
+
+	if (IsValid(BeaconHostObject))
+	{
+		BeaconHostObject->Destroy();
+	}
+
+	BeaconHost = nullptr;
+	BeaconHostObject = nullptr;
+}
+
+void UMssSubsystem::OnPostLoadMapWithWorld(UWorld* LoadedWorld)
+{
+	// Travel has picked the map up by now, unless this is only the transition map of a seamless travel
+	if (!LoadedWorld || !GEngine || !GEngine->SeamlessTravelHandlerForWorld(LoadedWorld).IsInTransition())
+	{
+		ReleasePreloadedMap();
+	}
+	
+	if (!bUseJoinReservations || !LoadedWorld || LoadedWorld->GetGameInstance() != GetGameInstance())
+		return;
+
+	const ENetMode NetMode = LoadedWorld->GetNetMode();
+	if (NetMode != NM_ListenServer && NetMode != NM_DedicatedServer)
+		return;
+
+	if (!SessionInterface.IsValid() || !SessionInterface->GetNamedSession(NAME_GameSession))
+		return;
+
+	StartBeaconHost(LoadedWorld);
+}
+
+#pragma endregion Join Reservations
+
+#pragma region Admission
+
+bool UMssSubsystem::CanAdmitPlayer(const FUniqueNetIdRepl& InPlayerId, int32 InNumPlayers, bool bInLobbyLocked, FString& OutRejectReason) const
+{
+	OutRejectReason.Empty();
+	
+	const FNamedOnlineSession* Session = SessionInterface.IsValid() ? SessionInterface->GetNamedSession(NAME_GameSession) : nullptr;
+	if (!Session)
+		return true;
+
+	const FOnlineSessionSettings& SessionSettings = Session->SessionSettings;
+	
+	switch (Session->SessionState)
+	{
+	case EOnlineSessionState::Pending:
+		if (bInLobbyLocked)
+		{
+			OutRejectReason = TEXT("Match is starting, the lobby is closed");
+		}
+		break;
+		
+	case EOnlineSessionState::Starting:
+		OutRejectReason = TEXT("Match is starting, the lobby is closed");
+		break;
+		
+	case EOnlineSessionState::InProgress:
+		if (!SessionSettings.bAllowJoinInProgress)
+		{
+			OutRejectReason = TEXT("Match is in progress and does not allow joining");
+		}
+		break;
+		
+	default:
+		OutRejectReason = FString::Printf(TEXT("Session is %s and takes no players"), EOnlineSessionState::ToString(Session->SessionState));
+		break;
+	}
+
+	if (OutRejectReason.IsEmpty())
+	{
+		// A party leader's own reservation is what holds its slots, only the other reservations stand in its way
+		const int32 OwnReservedSlots = InPlayerId.IsValid() && BeaconHostObject ? BeaconHostObject->GetReservedPartySize(InPlayerId) : 0;
+		const int32 NumReservedSlots = BeaconHostObject ? BeaconHostObject->GetNumReservedSlots() : 0;
+		const int32 NumTakenSlots = InNumPlayers + NumReservedSlots - OwnReservedSlots;
+		
+		if (NumTakenSlots >= SessionSettings.NumPublicConnections)
+		{
+			OutRejectReason = FString::Printf(TEXT("Session is full (%d/%d players, %d slot(s) reserved)"),
+				InNumPlayers, SessionSettings.NumPublicConnections, NumReservedSlots);
+		}
+	}
+
+	if (!OutRejectReason.IsEmpty())
+	{
+		LOG_INFO(TEXT("Refusing login of %s: %s"), *InPlayerId.ToString(), *OutRejectReason);
+		return false;
+	}
+
+	return true;
+}
+
+FString UMssSubsystem::ConsumeJoinRejectReason()
+{
+	return MoveTemp(LastJoinRejectReason);
+}
+
+void UMssSubsystem::OnNetworkFailure(UWorld* World, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString)
+{
+	// The reason given in PreLogin reaches the client as a failure of its pending connection
+	if (FailureType != ENetworkFailure::PendingConnectionFailure || !GetGameInstance() || (World && World->GetGameInstance() != GetGameInstance()))
+		return;
+
+	LOG_WARNING(TEXT("Host refused the connection: %s"), *ErrorString);
+	
+	LastJoinRejectReason = ErrorString;
+}
+
+#pragma endregion Admission
+
+#pragma region Heartbeat
+
+int64 UMssSubsystem::GetHeartbeatTimestamp()
+{
+	return FDateTime::UtcNow().ToUnixTimestamp();
+}
+
+void UMssSubsystem::StartHeartbeat()
+{
+	if (HeartbeatIntervalInSeconds <= 0.f)
+		return;
+
+	GetGameInstance()->GetTimerManager().SetTimer(HeartbeatTimerHandle, this, &ThisClass::SendHeartbeat, HeartbeatIntervalInSeconds, true);
+}
+
+void UMssSubsystem::StopHeartbeat()
+{
+	if (const UGameInstance* GameInstance = GetGameInstance())
+	{
+		GameInstance->GetTimerManager().ClearTimer(HeartbeatTimerHandle);
+	}
+}
+
+void UMssSubsystem::SendHeartbeat()
+{
+	FNamedOnlineSession* Session = SessionInterface.IsValid() ? SessionInterface->GetNamedSession(NAME_GameSession) : nullptr;
+	if (!Session)
+	{
+		StopHeartbeat();
+		return;
+	}
+
+	FOnlineSessionSettings UpdatedSessionSettings = Session->SessionSettings;
+	UpdatedSessionSettings.Set(SETTING_HEARTBEAT, GetHeartbeatTimestamp(), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	
+	if (!SessionInterface->UpdateSession(NAME_GameSession, UpdatedSessionSettings, true))
+	{
+		LOG_WARNING(TEXT("Heartbeat could not be advertised"));
+	}
+}
+
+void UMssSubsystem::FilterStaleSearchResults(TArray<FOnlineSessionSearchResult>& SearchResults) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSubsystem::FilterStaleSearchResults);
+	
+	if (StaleHeartbeatThresholdInSeconds <= 0.f)
+		return;
+
+	const int64 OldestHeartbeat = GetHeartbeatTimestamp() - static_cast<int64>(StaleHeartbeatThresholdInSeconds);
+	
+	const int32 NumStale = SearchResults.RemoveAll([OldestHeartbeat](const FOnlineSessionSearchResult& SearchResult)
+	{
+		int64 Heartbeat = 0;
+		return SearchResult.Session.SessionSettings.Get(SETTING_HEARTBEAT, Heartbeat) && Heartbeat < OldestHeartbeat;
+	});
+
+	if (NumStale > 0)
+	{
+		LOG_INFO(TEXT("Dropped %d session(s) without a heartbeat in the last %.0fs"), NumStale, StaleHeartbeatThresholdInSeconds);
+	}
+}
+
+#pragma endregion Heartbeat
+
+#pragma region Failed Joins
+
+bool UMssSubsystem::GetFailedJoin(const FString& InSessionId, EOnJoinSessionCompleteResult::Type& OutResult) const
+{
+	const FMssFailedJoin* FailedJoin = FailedJoins.Find(InSessionId);
+	if (!FailedJoin || FailedJoin->ExpiresAtSeconds <= FPlatformTime::Seconds())
+		return false;
+
+	OutResult = FailedJoin->Result;
+	return true;
+}
+
+void UMssSubsystem::ClearFailedJoins()
+{
+	FailedJoins.Empty();
+}
+
+void UMssSubsystem::RecordFailedJoin(const FString& InSessionId, EOnJoinSessionCompleteResult::Type InResult)
+{
+	if (InSessionId.IsEmpty())
+		return;
+
+	float LifetimeInSeconds = 0.f;
+	switch (InResult)
+	{
+	case EOnJoinSessionCompleteResult::SessionIsFull:
+		LifetimeInSeconds = FailedJoinSessionFullLifetimeInSeconds;
+		break;
+	case EOnJoinSessionCompleteResult::SessionDoesNotExist:
+		LifetimeInSeconds = FailedJoinSessionGoneLifetimeInSeconds;
+		break;
+	case EOnJoinSessionCompleteResult::CouldNotRetrieveAddress:
+		LifetimeInSeconds = FailedJoinNoAddressLifetimeInSeconds;
+		break;
+	default:
+		// Other failures are on this side or transient, the next attempt may well succeed
+		return;
+	}
+
+	if (LifetimeInSeconds <= 0.f)
+		return;
+
+	FMssFailedJoin& FailedJoin = FailedJoins.FindOrAdd(InSessionId);
+	FailedJoin.Result = InResult;
+	FailedJoin.ExpiresAtSeconds = FPlatformTime::Seconds() + LifetimeInSeconds;
+
+	LOG_INFO(TEXT("Hiding session %s for %.0fs after %s"), *InSessionId, LifetimeInSeconds, LexToString(InResult));
+}
+
+void UMssSubsystem::PruneFailedJoins()
+{
+	const double NowSeconds = FPlatformTime::Seconds();
+	
+	for (auto It = FailedJoins.CreateIterator(); It; ++It)
+	{
+		if (It.Value().ExpiresAtSeconds <= NowSeconds)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UMssSubsystem::FilterFailedJoinSearchResults(TArray<FOnlineSessionSearchResult>& SearchResults)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSubsystem::FilterFailedJoinSearchResults);
+	
+	PruneFailedJoins();
+	
+	if (FailedJoins.IsEmpty())
+		return;
+
+	const int32 NumHidden = SearchResults.RemoveAll([this](const FOnlineSessionSearchResult& SearchResult)
+	{
+		return FailedJoins.Contains(SearchResult.GetSessionIdStr());
+	});
+
+	if (NumHidden > 0)
+	{
+		LOG_INFO(TEXT("Hid %d session(s) a join has recently failed on"), NumHidden);
+	}
+}
+
+#pragma endregion Failed Joins
+
+#pragma region Friends
+
+void UMssSubsystem::JoinFriend(const FUniqueNetIdRepl& InFriendId)
+{
+	LOG_INFO(TEXT("Called"));
+
+	if (!SessionInterface.IsValid() || !InFriendId.IsValid() || bHasShutDown)
+	{
+		LOG_ERROR(TEXT("JoinFriend cannot look up the session of %s"), *InFriendId.ToString());
+		MultiplayerSessionsOnJoinSessionsComplete.Broadcast(EOnJoinSessionCompleteResult::UnknownError);
+		return;
+	}
+
+	const int32 LocalUserNum = GetLocalUserNum();
+
+	// A single lookup on the presence of the friend, no session search is issued
+	SessionInterface->ClearOnFindFriendSessionCompleteDelegate_Handle(LocalUserNum, FindFriendSessionCompleteDelegateHandle);
+	FindFriendSessionCompleteDelegateHandle = SessionInterface->AddOnFindFriendSessionCompleteDelegate_Handle(LocalUserNum, FindFriendSessionCompleteDelegate);
+	
+	if (!SessionInterface->FindFriendSession(LocalUserNum, *InFriendId))
+	{
+		LOG_ERROR(TEXT("Call to session interface find friend session function failed"));
+		
+		SessionInterface->ClearOnFindFriendSessionCompleteDelegate_Handle(LocalUserNum, FindFriendSessionCompleteDelegateHandle);
+		MultiplayerSessionsOnJoinSessionsComplete.Broadcast(EOnJoinSessionCompleteResult::SessionDoesNotExist);
+	}
+}
+
+void UMssSubsystem::JoinPresenceSession(const FOnlineSessionSearchResult& InSessionToJoin)
+{
+	if (!SessionInterface.IsValid() || bHasShutDown)
+		return;
+
+	// The player is in another session, leave it before joining the friend
+	if (SessionInterface->GetNamedSession(NAME_GameSession))
+	{
+		LOG_INFO(TEXT("Leaving the active session before joining %s"), *InSessionToJoin.GetSessionIdStr());
+		
+		bJoinSessionOnDestroy = true;
+		SessionToJoinAfterDestruction = InSessionToJoin;
+		
+		DestroySession();
+		return;
+	}
+
+	FOnlineSessionSearchResult SessionToJoin = InSessionToJoin;
+	RequestJoinSession(SessionToJoin, 1, true);
+}
+
+bool UMssSubsystem::ClientTravelToSession() const
+{
+	// A replayed join has no host behind it, the join flow ends here
+	if (IsReplaying())
+	{
+		LOG_INFO(TEXT("Replayed join, not travelling"));
+		return true;
+	}
+	
+	FString ConnectString;
+	if (!SessionInterface.IsValid() || !SessionInterface->GetResolvedConnectString(NAME_GameSession, ConnectString))
+	{
+		LOG_ERROR(TEXT("Failed to find the address of the session to join"));
+		return false;
+	}
+
+	APlayerController* PlayerController = GetGameInstance()->GetFirstLocalPlayerController();
+	if (!PlayerController)
+		return false;
+
+	// Several listeners may react to the same join, only the first one travels
+	if (const FWorldContext* WorldContext = GEngine ? GEngine->GetWorldContextFromWorld(GetWorld()) : nullptr;
+		WorldContext && WorldContext->TravelURL == ConnectString)
+	{
+		return true;
+	}
+
+	PlayerController->ClientTravel(ConnectString, TRAVEL_Absolute);
+	
+	return true;
+}
+
+int32 UMssSubsystem::GetLocalUserNum() const
+{
+	const UGameInstance* GameInstance = GetGameInstance();
+	const ULocalPlayer* LocalPlayer = GameInstance ? GameInstance->GetFirstGamePlayer() : nullptr;
+	
+	return LocalPlayer ? LocalPlayer->GetControllerId() : 0;
+}
+
+void UMssSubsystem::OnFindFriendSessionCompleteCallback(int32 LocalUserNum, bool bWasSuccessful, const TArray<FOnlineSessionSearchResult>& FriendSearchResults)
+{
+	if (SessionInterface.IsValid())
+	{
+		SessionInterface->ClearOnFindFriendSessionCompleteDelegate_Handle(LocalUserNum, FindFriendSessionCompleteDelegateHandle);
+	}
+
+	const FOnlineSessionSearchResult* FriendSession = FriendSearchResults.FindByPredicate([](const FOnlineSessionSearchResult& SearchResult)
+	{
+		return SearchResult.IsValid();
+	});
+
+	if (!bWasSuccessful || !FriendSession)
+	{
+		LOG_WARNING(TEXT("Friend is not in a joinable session"));
+		MultiplayerSessionsOnJoinSessionsComplete.Broadcast(EOnJoinSessionCompleteResult::SessionDoesNotExist);
+		return;
+	}
+
+	JoinPresenceSession(*FriendSession);
+}
+
+void UMssSubsystem::OnSessionUserInviteAcceptedCallback(const bool bWasSuccessful, const int32 ControllerId, FUniqueNetIdPtr UserId, const FOnlineSessionSearchResult& InviteResult)
+{
+	if (!bWasSuccessful || !InviteResult.IsValid())
+	{
+		LOG_WARNING(TEXT("Accepted invite does not lead to a joinable session"));
+		return;
+	}
+
+	LOG_INFO(TEXT("Invite accepted, joining %s"), *InviteResult.GetSessionIdStr());
+	
+	JoinPresenceSession(InviteResult);
+}
+
+void UMssSubsystem::OnSessionInviteReceivedCallback(const FUniqueNetId& UserId, const FUniqueNetId& FromId, const FString& AppId, const FOnlineSessionSearchResult& InviteResult)
+{
+	LOG_INFO(TEXT("Invite received from %s"), *FromId.ToString());
+	
+	MultiplayerSessionsOnSessionInviteReceived.Broadcast(FromId, InviteResult);
+}
+
+#pragma endregion Friends
+
+#pragma region Regions
+
+namespace MssRegions
+{
+	/** Region of the countries players mostly come from, by ISO 3166 country code */
+	static const TMap<FString, FString>& GetCountryRegions()
+	{
+		static const TMap<FString, FString> CountryRegions =
+		{
+			{ TEXT("US"), TEXT("NA") }, { TEXT("CA"), TEXT("NA") }, { TEXT("MX"), TEXT("NA") },
+			{ TEXT("BR"), TEXT("SA") }, { TEXT("AR"), TEXT("SA") }, { TEXT("CL"), TEXT("SA") }, { TEXT("CO"), TEXT("SA") }, { TEXT("PE"), TEXT("SA") },
+			{ TEXT("GB"), TEXT("EU") }, { TEXT("IE"), TEXT("EU") }, { TEXT("FR"), TEXT("EU") }, { TEXT("DE"), TEXT("EU") }, { TEXT("ES"), TEXT("EU") },
+			{ TEXT("PT"), TEXT("EU") }, { TEXT("IT"), TEXT("EU") }, { TEXT("NL"), TEXT("EU") }, { TEXT("BE"), TEXT("EU") }, { TEXT("CH"), TEXT("EU") },
+			{ TEXT("AT"), TEXT("EU") }, { TEXT("PL"), TEXT("EU") }, { TEXT("CZ"), TEXT("EU") }, { TEXT("SE"), TEXT("EU") }, { TEXT("NO"), TEXT("EU") },
+			{ TEXT("DK"), TEXT("EU") }, { TEXT("FI"), TEXT("EU") }, { TEXT("UA"), TEXT("EU") }, { TEXT("RO"), TEXT("EU") }, { TEXT("GR"), TEXT("EU") },
+			{ TEXT("RU"), TEXT("EU") }, { TEXT("TR"), TEXT("ME") }, { TEXT("AE"), TEXT("ME") }, { TEXT("SA"), TEXT("ME") }, { TEXT("IL"), TEXT("ME") },
+			{ TEXT("EG"), TEXT("AF") }, { TEXT("ZA"), TEXT("AF") }, { TEXT("NG"), TEXT("AF") }, { TEXT("KE"), TEXT("AF") },
+			{ TEXT("IN"), TEXT("ASIA") }, { TEXT("PK"), TEXT("ASIA") }, { TEXT("CN"), TEXT("ASIA") }, { TEXT("JP"), TEXT("ASIA") }, { TEXT("KR"), TEXT("ASIA") },
+			{ TEXT("TW"), TEXT("ASIA") }, { TEXT("HK"), TEXT("ASIA") }, { TEXT("SG"), TEXT("ASIA") }, { TEXT("TH"), TEXT("ASIA") }, { TEXT("VN"), TEXT("ASIA") },
+			{ TEXT("PH"), TEXT("ASIA") }, { TEXT("ID"), TEXT("ASIA") }, { TEXT("MY"), TEXT("ASIA") },
+			{ TEXT("AU"), TEXT("OCE") }, { TEXT("NZ"), TEXT("OCE") },
+		};
+		
+		return CountryRegions;
+	}
+}
+
+void UMssSubsystem::DetectLocalRegion()
+{
+	FString CommandLineRegion;
+	if (FParse::Value(FCommandLine::Get(), TEXT("MssRegion="), CommandLineRegion))
+	{
+		Region = CommandLineRegion;
+	}
+
+	// Nothing configured, guess from the country of the system locale
+	if (Region.IsEmpty() && bGuessRegionFromLocale)
+	{
+		const FString Country = FInternationalization::Get().GetDefaultLocale()->GetRegion();
+		if (const FString* CountryRegion = MssRegions::GetCountryRegions().Find(Country))
+		{
+			Region = *CountryRegion;
+		}
+	}
+
+	Region.ToUpperInline();
+
+	LOG_INFO(TEXT("Local region: %s"), Region.IsEmpty() ? TEXT("unknown, searching every region") : *Region);
+}
+
+void UMssSubsystem::GetSearchRegions(TArray<FString>& OutSearchRegions) const
+{
+	if (Region.IsEmpty())
+		return;
+
+	OutSearchRegions.Add(Region);
+
+	if (const FString* Neighbours = RegionNeighbours.Find(Region))
+	{
+		TArray<FString> NeighbourRegions;
+		Neighbours->ParseIntoArray(NeighbourRegions, TEXT(","));
+		
+		for (FString& NeighbourRegion : NeighbourRegions)
+		{
+			NeighbourRegion.TrimStartAndEndInline();
+			OutSearchRegions.AddUnique(NeighbourRegion.ToUpper());
+		}
+	}
+
+	// Hosts of regions nobody lists as a neighbour, or of no known region, are only found unscoped
+	OutSearchRegions.Add(FString());
+}
+
+#pragma endregion Regions
+
+#pragma region Latency Probes
+
+bool UMssSubsystem::GetLowestLatencySearchResult(FOnlineSessionSearchResult& OutSearchResult) const
+{
+	int32 BestIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < SearchResultStore.Num(); ++Index)
+	{
+		EOnJoinSessionCompleteResult::Type FailedJoinResult;
+		if (SearchResultStore.GetOpenSlots(Index) <= 0 || GetFailedJoin(SearchResultStore.GetSessionId(Index), FailedJoinResult))
+			continue;
+
+		if (BestIndex == INDEX_NONE || SearchResultStore.GetPingInMs(Index) < SearchResultStore.GetPingInMs(BestIndex))
+		{
+			BestIndex = Index;
+		}
+	}
+
+	return SearchResultStore.MakeSearchResult(BestIndex, OutSearchResult);
+}
+
+bool UMssSubsystem::GetSearchResultById(const FString& InSessionId, FOnlineSessionSearchResult& OutSearchResult) const
+{
+	return SearchResultStore.MakeSearchResult(SearchResultStore.FindIndex(InSessionId), OutSearchResult);
+}
+
+bool UMssSubsystem::StartLatencyProbes()
+{
+	// Replayed results keep their recorded ping, there is no host to probe
+	if (!bProbeSessionLatency || !SessionInterface.IsValid() || !LastCreatedSessionSearch.IsValid() || IsReplaying())
+		return false;
+
+	UWorld* World = GetWorld();
+	if (!World || World->bIsTearingDown)
+		return false;
+
+	const double NowSeconds = FPlatformTime::Seconds();
+	for (auto It = MeasuredLatencies.CreateIterator(); It; ++It)
+	{
+		if (NowSeconds - It.Value().MeasuredAtSeconds > LatencyProbeCacheLifetimeInSeconds)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TArray<const FOnlineSessionSearchResult*> Candidates;
+	for (const FOnlineSessionSearchResult& SearchResult : LastCreatedSessionSearch->SearchResults)
+	{
+		int32 BeaconPort = 0;
+		if (SearchResult.Session.NumOpenPublicConnections > 0 &&
+			SearchResult.Session.SessionSettings.Get(SETTING_BEACONPORT, BeaconPort) &&
+			!MeasuredLatencies.Contains(SearchResult.GetSessionIdStr()))
+		{
+			Candidates.Add(&SearchResult);
+		}
+	}
+
+	Candidates.StableSort([](const FOnlineSessionSearchResult& A, const FOnlineSessionSearchResult& B)
+	{
+		return A.PingInMs < B.PingInMs;
+	});
+
+	for (const FOnlineSessionSearchResult* Candidate : Candidates)
+	{
+		if (ActiveLatencyProbes.Num() >= LatencyProbeCandidates)
+			break;
+
+		FString BeaconConnectInfo;
+		if (!SessionInterface->GetResolvedConnectString(*Candidate, NAME_BeaconPort, BeaconConnectInfo))
+			continue;
+
+		AMssBeaconClient* BeaconClient = World->SpawnActor<AMssBeaconClient>(AMssBeaconClient::StaticClass());
+		if (!BeaconClient)
+			continue;
+
+		const FString SessionId = Candidate->GetSessionIdStr();
+		BeaconClient->OnPingMeasured.BindUObject(this, &ThisClass::OnLatencyProbeCompleted, SessionId);
+		
+		if (!BeaconClient->RequestPing(BeaconConnectInfo))
+		{
+			BeaconClient->DestroyBeacon();
+			continue;
+		}
+
+		ActiveLatencyProbes.Add({ BeaconClient, SessionId });
+	}
+
+	if (ActiveLatencyProbes.IsEmpty())
+		return false;
+
+	LOG_INFO(TEXT("Probing %d session(s) for %.2fs"), ActiveLatencyProbes.Num(), LatencyProbeBudgetInSeconds);
+	
+	GetGameInstance()->GetTimerManager().SetTimer(LatencyProbeBudgetTimerHandle, this, &ThisClass::OnLatencyProbeBudgetExpired, LatencyProbeBudgetInSeconds, false);
+	
+	return true;
+}
+
+void UMssSubsystem::OnLatencyProbeCompleted(int32 RoundTripMs, FString SessionId)
+{
+	const int32 ProbeIndex = ActiveLatencyProbes.IndexOfByPredicate([&SessionId](const FMssLatencyProbe& Probe)
+	{
+		return Probe.SessionId == SessionId;
+	});
+	
+	if (ProbeIndex == INDEX_NONE)
+		return;
+
+	if (RoundTripMs >= 0)
+	{
+		MeasuredLatencies.Add(SessionId, { RoundTripMs, FPlatformTime::Seconds() });
+	}
+
+	DestroyBeaconClientNextTick(ActiveLatencyProbes[ProbeIndex].BeaconClient.Get());
+	ActiveLatencyProbes.RemoveAtSwap(ProbeIndex);
+
+	if (ActiveLatencyProbes.IsEmpty())
+	{
+		FinishLatencyProbes();
+	}
+}
+
+void UMssSubsystem::OnLatencyProbeBudgetExpired()
+{
+	LOG_INFO(TEXT("Probe budget spent, %d host(s) did not answer"), ActiveLatencyProbes.Num());
+	
+	FinishLatencyProbes();
+}
+
+void UMssSubsystem::FinishLatencyProbes()
+{
+	CancelLatencyProbes();
+	BroadcastSearchResults(bLastSearchWasSuccessful);
+}
+
+void UMssSubsystem::CancelLatencyProbes()
+{
+	if (const UGameInstance* GameInstance = GetGameInstance())
+	{
+		GameInstance->GetTimerManager().ClearTimer(LatencyProbeBudgetTimerHandle);
+	}
+	
+	for (const FMssLatencyProbe& Probe : ActiveLatencyProbes)
+	{
+		DestroyBeaconClientNextTick(Probe.BeaconClient.Get());
+	}
+	
+	ActiveLatencyProbes.Empty();
+}
+
+void UMssSubsystem::ApplyMeasuredLatencies(TArray<FOnlineSessionSearchResult>& SearchResults) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSubsystem::ApplyMeasuredLatencies);
+	
+	for (FOnlineSessionSearchResult& SearchResult : SearchResults)
+	{
+		if (const FMssMeasuredLatency* MeasuredLatency = MeasuredLatencies.Find(SearchResult.GetSessionIdStr()))
+		{
+			SearchResult.PingInMs = MeasuredLatency->RoundTripMs;
+		}
+	}
+
+	SearchResults.StableSort([](const FOnlineSessionSearchResult& A, const FOnlineSessionSearchResult& B)
+	{
+		return A.PingInMs < B.PingInMs;
+	});
+}
+
+void UMssSubsystem::BroadcastSearchResults(bool bWasSuccessful)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSubsystem::BroadcastSearchResults);
+	
+	if (!LastCreatedSessionSearch.IsValid())
+	{
+		BroadcastNoSearchResults(bWasSuccessful);
+		return;
+	}
+	
+	TArray<FOnlineSessionSearchResult>& SearchResults = LastCreatedSessionSearch->SearchResults;
+	
+	ApplyMeasuredLatencies(SearchResults);
+
+	// Results come sorted by latency, the ones past the budget are the farthest away
+	const int32 NumProjected = SearchResultStore.Project(SearchResults, static_cast<int64>(SearchResultStoreBudgetInKB) * 1024);
+	if (NumProjected < SearchResults.Num())
+	{
+		LOG_WARNING(TEXT("Kept %d of %d session(s) within the %dKB result budget"), NumProjected, SearchResults.Num(), SearchResultStoreBudgetInKB);
+		SearchResults.SetNum(NumProjected);
+	}
+
+	Stats.SearchResultsReceived += SearchResults.Num();
+	
+	MultiplayerSessionsOnFindSessionsComplete.Broadcast(SearchResults, bWasSuccessful);
+
+	// Listeners have copied what they need, rows keep session ids and look the rest up in the store
+	LastCreatedSessionSearch.Reset();
+}
+
+void UMssSubsystem::BroadcastNoSearchResults(bool bWasSuccessful)
+{
+	// The sessions of an earlier search must not be joined by id once a newer search found nothing
+	SearchResultStore.Reset();
+	LastCreatedSessionSearch.Reset();
+	
+	MultiplayerSessionsOnFindSessionsComplete.Broadcast(TArray<FOnlineSessionSearchResult>(), bWasSuccessful);
+}
+
+#pragma endregion Latency Probes
+
+#pragma region Map Preloading
+
+void UMssSubsystem::PreloadMap(const FString& InMapPath)
+{
+	FString PackageName = InMapPath;
+	InMapPath.Split(TEXT("?"), &PackageName, nullptr);
+
+	if (!FPackageName::IsValidLongPackageName(PackageName))
+	{
+		LOG_WARNING(TEXT("Cannot preload '%s', not a valid map package"), *InMapPath);
+		return;
+	}
+
+	// PIE travels to duplicated world packages so preloading the source package would only waste memory
+	if (const UWorld* World = GetWorld(); World && World->IsPlayInEditor())
+		return;
+
+	if (PackageName == PreloadedMapPackageName)
+		return;
+
+	ReleasePreloadedMap();
+	PreloadedMapPackageName = PackageName;
+
+	if (UWorld* LoadedWorld = UWorld::FindWorldInPackage(FindPackage(nullptr, *PackageName)))
+	{
+		PreloadedMapWorld = LoadedWorld;
+		return;
+	}
+
+	LOG_INFO(TEXT("Preloading %s"), *PackageName);
+	
+	LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateUObject(this, &ThisClass::OnMapPreloaded));
+}
+
+void UMssSubsystem::ReleasePreloadedMap()
+{
+	PreloadedMapWorld = nullptr;
+	PreloadedMapPackageName.Empty();
+}
+
+void UMssSubsystem::OnMapPreloaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+{
+	// Released or replaced by another preload while loading
+	if (PackageName.ToString() != PreloadedMapPackageName)
+		return;
+
+	UWorld* LoadedWorld = Result == EAsyncLoadingResult::Succeeded ? UWorld::FindWorldInPackage(LoadedPackage) : nullptr;
+	if (!LoadedWorld)
+	{
+		LOG_WARNING(TEXT("Failed to preload %s"), *PackageName.ToString());
+		ReleasePreloadedMap();
+		return;
+	}
+
+	LOG_INFO(TEXT("Preloaded %s"), *PackageName.ToString());
+	
+	PreloadedMapWorld = LoadedWorld;
+}
+
+#pragma endregion Map Preloading
+
+#pragma region Travel
+
+bool UMssSubsystem::ServerTravelToLobby(const FString& InLobbyMapPath)
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		LOG_ERROR(TEXT("No world to travel from"));
+		return false;
+	}
+
+	const FString TravelPath = InLobbyMapPath + FString("?listen");
+	LOG_INFO(TEXT("Server travel to path: %s"), *TravelPath);
+	
+	return World->ServerTravel(TravelPath);
+}
+
+bool UMssSubsystem::ServerTravelToMap(const FString& InMapPath)
+{
+	UWorld* World = GetWorld();
+	AGameModeBase* GameMode = World ? World->GetAuthGameMode() : nullptr;
+	if (!GameMode)
+	{
+		LOG_ERROR(TEXT("Only the host can move the session to %s"), *InMapPath);
+		return false;
+	}
+
+	if (!SessionInterface.IsValid() || !SessionInterface->GetNamedSession(NAME_GameSession))
+	{
+		LOG_ERROR(TEXT("No hosted session to move to %s"), *InMapPath);
+		return false;
+	}
+
+	GameMode->bUseSeamlessTravel = bUseSeamlessTravel;
+	
+	LOG_INFO(TEXT("%s travel to %s with %d player(s)"), bUseSeamlessTravel ? TEXT("Seamless") : TEXT("Hard"), *InMapPath, GameMode->GetNumPlayers());
+
+	if (bUseSeamlessTravel)
+	{
+		ApplyTransitionMap();
+	}
+	
+	if (!World->ServerTravel(InMapPath))
+	{
+		RestoreTransitionMap();
+		return false;
+	}
+
+	return true;
+}
+
+void UMssSubsystem::ApplyTransitionMap()
+{
+	// Left empty the project's own transition map is used
+	if (SeamlessTransitionMap.IsNull())
+		return;
+
+	UGameMapsSettings* GameMapsSettings = GetMutableDefault<UGameMapsSettings>();
+	
+	// Still overridden after a travel cancelled before its transition, the project's map was saved back then
+	if (!bTransitionMapOverridden)
+	{
+		ProjectTransitionMap = GameMapsSettings->TransitionMap;
+		bTransitionMapOverridden = true;
+		SeamlessTravelTransitionDelegateHandle = FWorldDelegates::OnSeamlessTravelTransition.AddUObject(this, &ThisClass::OnSeamlessTravelTransition);
+	}
+
+	GameMapsSettings->TransitionMap = SeamlessTransitionMap;
+}
+
+void UMssSubsystem::RestoreTransitionMap()
+{
+	if (!bTransitionMapOverridden)
+		return;
+
+	GetMutableDefault<UGameMapsSettings>()->TransitionMap = ProjectTransitionMap;
+	bTransitionMapOverridden = false;
+
+	FWorldDelegates::OnSeamlessTravelTransition.Remove(SeamlessTravelTransitionDelegateHandle);
+}
+
+void UMssSubsystem::OnSeamlessTravelTransition(UWorld* InWorld)
+{
+	// The transition map has been read once travel switches worlds, other travel must not see the override
+	if (InWorld && InWorld->GetGameInstance() == GetGameInstance())
+	{
+		RestoreTransitionMap();
+	}
+}
+
+bool UMssSubsystem::GetHostedSessionSettings(FTempCustomSessionSettings& OutSessionSettings) const
+{
+	const FNamedOnlineSession* Session = SessionInterface.IsValid() ? SessionInterface->GetNamedSession(NAME_GameSession) : nullptr;
+	if (!Session)
+		return false;
+
+	Session->SessionSettings.Get(SETTING_MAPNAME, OutSessionSettings.MapName);
+	Session->SessionSettings.Get(SETTING_GAMEMODE, OutSessionSettings.GameMode);
+	Session->SessionSettings.Get(SETTING_NUMPLAYERSREQUIRED, OutSessionSettings.Players);
+	
+	return true;
+}
+
+int32 UMssSubsystem::GetRequiredPlayerCount(const FString& InPlayers)
+{
+	if (InPlayers == "2v2") return 4;
+	if (InPlayers == "4v4") return 8;
+	
+	return 2;
+}
+
+#pragma endregion Travel
+
+#pragma region Stats
+
+const FMssStats& UMssSubsystem::SnapshotStats()
+{
+	Stats.CachedSearchResults = SearchResultStore.Num();
+	Stats.SearchResultStoreBytes = SearchResultStore.GetAllocatedSize();
+	Stats.CachedLatencies = MeasuredLatencies.Num();
+	Stats.IndexedSessionKeys = SessionListModel ? SessionListModel->GetEntries().Num() : 0;
+	
+	return Stats;
+}
+
+int32 UMssSubsystem::GetNumBoundOperationDelegates() const
+{
+	int32 NumBoundDelegates = 0;
+	for (const FDelegateHandle* DelegateHandle : { &CreateSessionCompleteDelegateHandle, &FindSessionsCompleteDelegateHandle, &CancelFindSessionsCompleteDelegateHandle,
+		&JoinSessionCompleteDelegateHandle, &DestroySessionCompleteDelegateHandle, &StartSessionCompleteDelegateHandle })
+	{
+		NumBoundDelegates += DelegateHandle->IsValid() ? 1 : 0;
+	}
+
+	return NumBoundDelegates;
+}
+
+void UMssSubsystem::DumpStats()
+{
+	SnapshotStats();
+	
+	const FString StatsDirectory = FPaths::ProjectSavedDir() / TEXT("Mss");
+	const FString JsonPath = StatsDirectory / TEXT("Stats.json");
+	const FString CsvPath = StatsDirectory / TEXT("Stats.csv");
+
+	if (!FFileHelper::SaveStringToFile(Stats.ToJsonString(), *JsonPath))
+	{
+		LOG_WARNING(TEXT("Could not write %s"), *JsonPath);
+	}
+
+	FString CsvRows;
+	if (!IFileManager::Get().FileExists(*CsvPath))
+	{
+		CsvRows = FMssStats::GetCsvHeader() + LINE_TERMINATOR;
+	}
+	CsvRows += Stats.ToCsvRow() + LINE_TERMINATOR;
+
+	if (!FFileHelper::SaveStringToFile(CsvRows, *CsvPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		LOG_WARNING(TEXT("Could not append to %s"), *CsvPath);
+	}
+}
+
+#pragma endregion Stats
+
+#pragma region Recording
+
+bool UMssSubsystem::StartRecording()
+{
+	if (IsRecording() || IsReplaying())
+		return false;
+
+	LOG_INFO(TEXT("Recording session backend traffic"));
+	
+	ActiveRecording = MakeUnique<FMssSessionRecording>();
+	ActiveRecording->RecordedAtUnixTime = FDateTime::UtcNow().ToUnixTimestamp();
+	RecordingStartedAtSeconds = FPlatformTime::Seconds();
+	RecordedOperationsInFlight.Reset();
+
+	return true;
+}
+
+bool UMssSubsystem::StopRecording(FString& OutPath)
+{
+	if (!IsRecording())
+		return false;
+
+	const TUniquePtr<FMssSessionRecording> Recording = MoveTemp(ActiveRecording);
+	RecordedOperationsInFlight.Reset();
+	
+	OutPath = FPaths::ProjectSavedDir() / TEXT("Mss") / TEXT("Recordings") / FString::Printf(TEXT("Sessions_%s.mssrec"), *FDateTime::Now().ToString());
+	if (!Recording->SaveToFile(OutPath))
+	{
+		LOG_WARNING(TEXT("Could not write %s"), *OutPath);
+		return false;
+	}
+
+	LOG_INFO(TEXT("Recorded %d session operation(s)"), Recording->Operations.Num());
+	
+	return true;
+}
+
+void UMssSubsystem::RecordOperationIssued(EMssTraceOperation InOperation, const FString& InSessionId)
+{
+	if (!ActiveRecording)
+		return;
+
+	FMssRecordedOperation& RecordedOperation = ActiveRecording->Operations.AddDefaulted_GetRef();
+	RecordedOperation.Operation = InOperation;
+	RecordedOperation.IssuedAtSeconds = FPlatformTime::Seconds() - RecordingStartedAtSeconds;
+	RecordedOperation.SessionId = InSessionId;
+
+	RecordedOperationsInFlight.Add(InOperation, ActiveRecording->Operations.Num() - 1);
+}
+
+void UMssSubsystem::RecordOperationCompleted(EMssTraceOperation InOperation, bool bWasSuccessful, uint8 InJoinResult, const TArray<FOnlineSessionSearchResult>* InSearchResults)
+{
+	if (!ActiveRecording)
+		return;
+
+	int32 OperationIndex = INDEX_NONE;
+	if (!RecordedOperationsInFlight.RemoveAndCopyValue(InOperation, OperationIndex))
+	{
+		LOG_WARNING(TEXT("Completion of %d matches no operation in flight"), static_cast<int32>(InOperation));
+		++ActiveRecording->NumUnmatchedCompletions;
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSubsystem::RecordOperationCompleted);
+	
+	FMssRecordedOperation& RecordedOperation = ActiveRecording->Operations[OperationIndex];
+	RecordedOperation.CompletedAtSeconds = FPlatformTime::Seconds() - RecordingStartedAtSeconds;
+	RecordedOperation.bWasSuccessful = bWasSuccessful;
+	RecordedOperation.JoinResult = InJoinResult;
+
+	if (InSearchResults)
+	{
+		RecordedOperation.Results.Reserve(InSearchResults->Num());
+		for (const FOnlineSessionSearchResult& SearchResult : *InSearchResults)
+		{
+			RecordedOperation.Results.Add(FMssRecordedSession::FromSearchResult(SearchResult));
+		}
+	}
+}
+
+void UMssSubsystem::RecordOperationCancelled(EMssTraceOperation InOperation)
+{
+	int32 OperationIndex = INDEX_NONE;
+	if (!ActiveRecording || !RecordedOperationsInFlight.RemoveAndCopyValue(InOperation, OperationIndex))
+		return;
+
+	FMssRecordedOperation& RecordedOperation = ActiveRecording->Operations[OperationIndex];
+	RecordedOperation.CompletedAtSeconds = FPlatformTime::Seconds() - RecordingStartedAtSeconds;
+	RecordedOperation.bWasCancelled = true;
+}
+
+#pragma endregion Recording
+
+#pragma region Replay
+
+bool UMssSubsystem::StartReplay(const FString& InPath, float InTimeScale)
+{
+	if (IsRecording())
+	{
+		LOG_WARNING(TEXT("Cannot replay while recording"));
+		return false;
+	}
+
+	TUniquePtr<FMssSessionRecording> Recording = MakeUnique<FMssSessionRecording>();
+	if (!Recording->LoadFromFile(InPath))
+	{
+		LOG_ERROR(TEXT("Could not load the session recording %s"), *InPath);
+		return false;
+	}
+
+	const bool bHasReplayableOperation = Recording->Operations.ContainsByPredicate([](const FMssRecordedOperation& Operation)
+	{
+		return !Operation.bWasCancelled && !Operation.IsInFlight() && (Operation.Operation == EMssTraceOperation::FindSessions || Operation.Operation == EMssTraceOperation::JoinSession);
+	});
+	
+	if (!bHasReplayableOperation)
+	{
+		LOG_ERROR(TEXT("The session recording %s holds no completed search nor join"), *InPath);
+		return false;
+	}
+
+	// Whatever the backend was doing is superseded by the replay
+	if (bFindSessionsInProgress)
+	{
+		CancelFindSessions();
+	}
+
+	LOG_INFO(TEXT("Replaying %d session operation(s) from %s at %.2fx the recorded timings"), Recording->Operations.Num(), *InPath, InTimeScale);
+	
+	ReplayRecording = MoveTemp(Recording);
+	ReplayTimeScale = FMath::Max(InTimeScale, 0.f);
+	NextReplayedFindIndex = 0;
+	NextReplayedJoinIndex = 0;
+
+	// Results of the real backend are not joinable through the replay and the other way around
+	if (SessionListModel)
+	{
+		SessionListModel->Reset();
+	}
+
+	return true;
+}
+
+void UMssSubsystem::StopReplay()
+{
+	if (!IsReplaying())
+		return;
+
+	LOG_INFO(TEXT("Replay stopped"));
+
+	if (bFindSessionsInProgress)
+	{
+		CancelFindSessions();
+	}
+	
+	if (const UGameInstance* GameInstance = GetGameInstance())
+	{
+		GameInstance->GetTimerManager().ClearTimer(ReplayFindSessionsTimerHandle);
+		GameInstance->GetTimerManager().ClearTimer(ReplayJoinSessionTimerHandle);
+	}
+
+	// A replayed join is only answered by the timer cleared above
+	bJoinInProgress = false;
+	bTravelOnJoinComplete = false;
+	
+	ReplayRecording.Reset();
+	SearchResultStore.Reset();
+
+	if (SessionListModel)
+	{
+		SessionListModel->Reset();
+	}
+}
+
+int32 UMssSubsystem::FindNextReplayedOperation(EMssTraceOperation InOperation, int32& InOutNextIndex, const FString& InSessionId) const
+{
+	const TArray<FMssRecordedOperation>& Operations = ReplayRecording->Operations;
+	const int32 NumOperations = Operations.Num();
+	
+	int32 FallbackIndex = INDEX_NONE;
+	
+	for (int32 Offset = 0; Offset < NumOperations; ++Offset)
+	{
+		const int32 Index = (InOutNextIndex + Offset) % NumOperations;
+		const FMssRecordedOperation& Operation = Operations[Index];
+		if (Operation.Operation != InOperation || Operation.bWasCancelled || Operation.IsInFlight())
+			continue;
+
+		if (InSessionId.IsEmpty() || Operation.SessionId == InSessionId)
+		{
+			InOutNextIndex = Index + 1;
+			return Index;
+		}
+
+		if (FallbackIndex == INDEX_NONE)
+		{
+			FallbackIndex = Index;
+		}
+	}
+
+	if (FallbackIndex != INDEX_NONE)
+	{
+		InOutNextIndex = FallbackIndex + 1;
+	}
+	
+	return FallbackIndex;
+}
+
+void UMssSubsystem::ReplayFindSessions(uint32 InSearchGeneration)
+{
+	const int32 OperationIndex = FindNextReplayedOperation(EMssTraceOperation::FindSessions, NextReplayedFindIndex);
+	
+	// A recording of joins only answers every search with nothing
+	const float DelayInSeconds = OperationIndex != INDEX_NONE ? ReplayRecording->Operations[OperationIndex].GetDurationSeconds() * ReplayTimeScale : 0.f;
+	const FTimerDelegate ReplayDelegate = FTimerDelegate::CreateUObject(this, &ThisClass::OnReplayedFindSessionsComplete, InSearchGeneration, OperationIndex);
+	
+	FTimerManager& TimerManager = GetGameInstance()->GetTimerManager();
+	if (DelayInSeconds > 0.f)
+	{
+		TimerManager.SetTimer(ReplayFindSessionsTimerHandle, ReplayDelegate, DelayInSeconds, false);
+	}
+	else
+	{
+		ReplayFindSessionsTimerHandle = TimerManager.SetTimerForNextTick(ReplayDelegate);
+	}
+}
+
+void UMssSubsystem::OnReplayedFindSessionsComplete(uint32 InSearchGeneration, int32 InOperationIndex)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSubsystem::OnReplayedFindSessionsComplete);
+	
+	if (InSearchGeneration != SearchGeneration || !bFindSessionsInProgress || !IsReplaying() || !LastCreatedSessionSearch.IsValid())
+		return;
+
+	bool bWasSuccessful = true;
+	
+	if (ReplayRecording->Operations.IsValidIndex(InOperationIndex))
+	{
+		const FMssRecordedOperation& Operation = ReplayRecording->Operations[InOperationIndex];
+		bWasSuccessful = Operation.bWasSuccessful;
+
+		// Heartbeats keep the age they had when recorded, otherwise every replayed session would be stale
+		const int64 HeartbeatShiftSeconds = FDateTime::UtcNow().ToUnixTimestamp() - (ReplayRecording->RecordedAtUnixTime + static_cast<int64>(Operation.CompletedAtSeconds));
+		
+		TArray<FOnlineSessionSearchResult>& SearchResults = LastCreatedSessionSearch->SearchResults;
+		SearchResults.Reset(Operation.Results.Num());
+		
+		for (const FMssRecordedSession& RecordedSession : Operation.Results)
+		{
+			FOnlineSessionSearchResult& SearchResult = SearchResults.Add_GetRef(RecordedSession.ToSearchResult());
+			
+			int64 Heartbeat = 0;
+			if (SearchResult.Session.SessionSettings.Get(SETTING_HEARTBEAT, Heartbeat))
+			{
+				SearchResult.Session.SessionSettings.Set(SETTING_HEARTBEAT, Heartbeat + HeartbeatShiftSeconds, EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+			}
+		}
+	}
+
+	LastCreatedSessionSearch->SearchState = bWasSuccessful ? EOnlineAsyncTaskState::Done : EOnlineAsyncTaskState::Failed;
+	
+	CompleteFindSessions(bWasSuccessful);
+}
+
+void UMssSubsystem::ReplayJoinSession(const FString& InSessionId)
+{
+	const int32 OperationIndex = FindNextReplayedOperation(EMssTraceOperation::JoinSession, NextReplayedJoinIndex, InSessionId);
+
+	EOnJoinSessionCompleteResult::Type Result = EOnJoinSessionCompleteResult::UnknownError;
+	float DelayInSeconds = 0.f;
+	
+	if (OperationIndex != INDEX_NONE)
+	{
+		const FMssRecordedOperation& Operation = ReplayRecording->Operations[OperationIndex];
+		Result = static_cast<EOnJoinSessionCompleteResult::Type>(Operation.JoinResult);
+		DelayInSeconds = Operation.GetDurationSeconds() * ReplayTimeScale;
+	}
+	else
+	{
+		LOG_WARNING(TEXT("The recording holds no join, answering %s"), LexToString(Result));
+	}
+
+	const FTimerDelegate ReplayDelegate = FTimerDelegate::CreateUObject(this, &ThisClass::OnJoinSessionCompleteCallback, FName(NAME_GameSession), Result);
+	
+	FTimerManager& TimerManager = GetGameInstance()->GetTimerManager();
+	if (DelayInSeconds > 0.f)
+	{
+		TimerManager.SetTimer(ReplayJoinSessionTimerHandle, ReplayDelegate, DelayInSeconds, false);
+	}
+	else
+	{
+		ReplayJoinSessionTimerHandle = TimerManager.SetTimerForNextTick(ReplayDelegate);
+	}
+}
+
+#pragma endregion Replay
+
+FString UMssSubsystem::GenerateSessionUniqueCode() const
+{
+	const FDateTime CurrentTime = FDateTime::Now();
+	const FString SumOfCurrentTime = FString::Printf(TEXT("%d%d%03d"), CurrentTime.GetMinute(), CurrentTime.GetSecond(), CurrentTime.GetMillisecond());
+
+	LOG_INFO(TEXT("Generated session code '%s'"), *SumOfCurrentTime);
+
+	return SumOfCurrentTime;
+}
+
+#pragma region Session Operations On Completion Delegates Callbacks
+	
+void UMssSubsystem::OnCreateSessionCompleteCallback(FName SessionName, bool bWasSuccessful)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSubsystem::OnCreateSessionCompleteCallback);
+	
+	LOG_INFO(TEXT("Created session : %s"), bWasSuccessful ? TEXT("success") : TEXT("failed"));
+
+	MssTrace::EndOperation(EMssTraceOperation::CreateSession, CreateSessionTraceId, bWasSuccessful);
+	RecordOperationCompleted(EMssTraceOperation::CreateSession, bWasSuccessful);
+
+	if (SessionInterface)
+		SessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegateHandle); 
+
+	if (const FNamedOnlineSession* Session = SessionInterface->GetNamedSession(NAME_GameSession); bWasSuccessful)
+	{
+		FString SessionCode;
+		Session->SessionSettings.Get(SETTING_SESSIONKEY, SessionCode);
+		// Display session key
+
+		StartHeartbeat();
+	}
+	else
+	{
+		ReleasePreloadedMap();
+	}
+	
+	MultiplayerSessionsOnCreateSessionComplete.Broadcast(bWasSuccessful);	
+}
+
+void UMssSubsystem::OnFindSessionsCompleteCallback(bool bWasSuccessful)
+{
+	// The session interface reports completions without telling which search they belong to, and cancelling unbinds the old search
+	// So a cancelled search completing late lands here as well, it finishes its own search object and leaves the active one in progress
+	if (LastCreatedSessionSearch.IsValid() && LastCreatedSessionSearch->SearchState == EOnlineAsyncTaskState::InProgress)
+	{
+		LOG_INFO(TEXT("Dropping completion of a superseded search, search %u still in progress"), SearchGeneration);
+		return;
+	}
+
+	CompleteFindSessions(bWasSuccessful);
+}
+
+void UMssSubsystem::OnCancelFindSessionsCompleteCallback(bool bWasSuccessful)
+{
+	LOG_INFO(TEXT("Cancel search : %s"), bWasSuccessful ? TEXT("success") : TEXT("failed"));
+
+	if (SessionInterface.IsValid())
+	{
+		SessionInterface->ClearOnCancelFindSessionsCompleteDelegate_Handle(CancelFindSessionsCompleteDelegateHandle);
+	}
+	
+	CancelFindSessionsCompleteDelegateHandle.Reset();
+}
+
+void UMssSubsystem::CompleteFindSessions(bool bWasSuccessful)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSubsystem::CompleteFindSessions);
+	
+	LOG_INFO(TEXT("Found sessions : %s"), bWasSuccessful ? TEXT("success") : TEXT("failed"));
+
+	// Ends the backend part of the search, probing and broadcasting are client side processing
+	MssTrace::EndOperation(EMssTraceOperation::FindSessions, FindSessionsTraceId, bWasSuccessful);
+	RecordOperationCompleted(EMssTraceOperation::FindSessions, bWasSuccessful, 0, LastCreatedSessionSearch.IsValid() ? &LastCreatedSessionSearch->SearchResults : nullptr);
+
+	bFindSessionsInProgress = false;
+	
+	GetGameInstance()->GetTimerManager().ClearTimer(LanSearchTimeoutTimerHandle);
+	
+	if (SessionInterface)
+	{
+		SessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
+	}
+
+	if (!LastCreatedSessionSearch.IsValid())
+	{
+		LOG_ERROR(TEXT("LastCreatedSessionSearch is Invalid"));
+		BroadcastNoSearchResults(bWasSuccessful);
+		return;
+	}
+
+	if (LastCreatedSessionSearch->bIsLanQuery)
+	{
+		FilterLanSearchResults(LastCreatedSessionSearch->SearchResults);
+	}
+
+	FilterStaleSearchResults(LastCreatedSessionSearch->SearchResults);
+	FilterFailedJoinSearchResults(LastCreatedSessionSearch->SearchResults);
+
+	// Too few sessions close by, keep them and look in the next neighbouring region
+	// The unscoped last step finds the sessions of the regions searched before again
+	TSet<FString> FoundSessionIds;
+	FoundSessionIds.Reserve(RegionSearchResults.Num());
+	for (const FOnlineSessionSearchResult& Found : RegionSearchResults)
+	{
+		FoundSessionIds.Add(Found.GetSessionIdStr());
+	}
+
+	for (FOnlineSessionSearchResult& SearchResult : LastCreatedSessionSearch->SearchResults)
+	{
+		bool bAlreadyFound = false;
+		FoundSessionIds.Add(SearchResult.GetSessionIdStr(), &bAlreadyFound);
+		
+		if (!bAlreadyFound)
+		{
+			RegionSearchResults.Add(MoveTemp(SearchResult));
+		}
+	}
+	LastCreatedSessionSearch->SearchResults.Reset();
+	
+	if (bWasSuccessful && !PendingSearchRegions.IsEmpty() && RegionSearchResults.Num() < MinRegionSearchResults)
+	{
+		LOG_INFO(TEXT("%d session(s) found so far, widening the search"), RegionSearchResults.Num());
+		IssueFindSessions();
+		return;
+	}
+
+	PendingSearchRegions.Reset();
+	LastCreatedSessionSearch->SearchResults = MoveTemp(RegionSearchResults);
+		
+	if (LastCreatedSessionSearch->SearchResults.IsEmpty())
+	{
+		LOG_WARNING(TEXT("Search result is empty no session found"));
+		BroadcastNoSearchResults(bWasSuccessful);
+		return;
+	}
+
+	bLastSearchWasSuccessful = bWasSuccessful;
+	
+	if (StartLatencyProbes())
+		return;
+
+	BroadcastSearchResults(bWasSuccessful);
+}
+
+void UMssSubsystem::OnJoinSessionCompleteCallback(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSubsystem::OnJoinSessionCompleteCallback);
+	
+	MssTrace::EndOperation(EMssTraceOperation::JoinSession, JoinSessionTraceId, Result == EOnJoinSessionCompleteResult::Success);
+	RecordOperationCompleted(EMssTraceOperation::JoinSession, Result == EOnJoinSessionCompleteResult::Success, Result);
+	
+	switch (Result)
+	{
 	case EOnJoinSessionCompleteResult::Success:
 		LOG_INFO(TEXT("Success"));
 		break;
@@ -358,29 +2346,78 @@ void UMssSubsystem::OnJoinSessionCompleteCallback(FName SessionName, EOnJoinSess
 		SessionInterface->ClearOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegateHandle);
 	}
 
+	if (Result == EOnJoinSessionCompleteResult::Success)
+	{
+		++Stats.JoinsSucceeded;
+		Stats.TotalTimeToJoinSeconds += FPlatformTime::Seconds() - JoinRequestedAtSeconds;
+
+		if (bTravelOnJoinComplete)
+		{
+			ClientTravelToSession();
+		}
+	}
+	else
+	{
+		RecordFailedJoin(PendingJoinSessionId, Result);
+		ReleasePreloadedMap();
+	}
+
+	bTravelOnJoinComplete = false;
+	bJoinInProgress = false;
+
 	MultiplayerSessionsOnJoinSessionsComplete.Broadcast(Result);
 }
 
 void UMssSubsystem::OnDestroySessionCompleteCallback(FName SessionName, bool bWasSuccessful)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSubsystem::OnDestroySessionCompleteCallback);
+	
 	LOG_INFO(TEXT("Destroy session : %s"), bWasSuccessful ? TEXT("success") : TEXT("failed"));
 
+	MssTrace::EndOperation(EMssTraceOperation::DestroySession, DestroySessionTraceId, bWasSuccessful);
+	RecordOperationCompleted(EMssTraceOperation::DestroySession, bWasSuccessful);
+
 	if (SessionInterface.IsValid())
 	{
 		SessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegateHandle);
 	}
 
+	if (bWasSuccessful)
+	{
+		StopBeaconHost();
+		StopHeartbeat();
+	}
+
 	if (bWasSuccessful && bCreateSessionOnDestroy)
 	{
 		bCreateSessionOnDestroy = false;
 		CreateSession(SessionSettingsForTheSessionToCreateAfterDestruction);
 	}
+	else
+	{
+		FailCreateSessionOnDestroy();
+	}
+
+	if (bJoinSessionOnDestroy)
+	{
+		bJoinSessionOnDestroy = false;
+		
+		if (bWasSuccessful)
+		{
+			JoinPresenceSession(SessionToJoinAfterDestruction);
+		}
+	}
 	
 	MultiplayerSessionsOnDestroySessionComplete.Broadcast(bWasSuccessful);
 }
 
 void UMssSubsystem::OnStartSessionCompleteCallback(FName SessionName, bool bWasSuccessful)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSubsystem::OnStartSessionCompleteCallback);
+	
+	MssTrace::EndOperation(EMssTraceOperation::StartSession, StartSessionTraceId, bWasSuccessful);
+	RecordOperationCompleted(EMssTraceOperation::StartSession, bWasSuccessful);
+	
 	LOG_INFO(TEXT("Start session : %s | Success: %s"),
 		*SessionName.ToString(), bWasSuccessful ? TEXT("true") : TEXT("false"));
 
@@ -394,6 +2431,17 @@ void UMssSubsystem::OnStartSessionCompleteCallback(FName SessionName, bool bWasS
 
 #pragma endregion Session Operations On Completion Delegates Callbacks
 
+void UMssSubsystem::FailCreateSessionOnDestroy()
+{
+	if (!bCreateSessionOnDestroy)
+		return;
+
+	bCreateSessionOnDestroy = false;
+
+	LOG_WARNING(TEXT("Active session could not be destroyed, session creation abandoned"));
+	MultiplayerSessionsOnCreateSessionComplete.Broadcast(false);
+}
+
 bool UMssSubsystem::IsSessionInState(EOnlineSessionState::Type State) const
 {
 	if (!SessionInterface.IsValid())
@@ -0,0 +1,229 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#include "System/MssSessionRecording.h"
+
+#include "OnlineSessionSettings.h"
+#include "OnlineSubsystemTypes.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace MssSessionRecording
+{
+	/** 'MSSR' */
+	constexpr uint32 FileMagic = 0x4D535352;
+	constexpr int32 FileVersion = 1;
+
+	const FName ReplayNetIdType(TEXT("MssReplay"));
+
+	/** Session info of a replayed result, only carries the recorded session id */
+	class FReplaySessionInfo : public FOnlineSessionInfo
+	{
+	public:
+		explicit FReplaySessionInfo(const FString& InSessionId)
+			: SessionId(FUniqueNetIdString::Create(InSessionId, ReplayNetIdType))
+		{
+		}
+
+		virtual const uint8* GetBytes() const override { return nullptr; }
+		virtual int32 GetSize() const override { return sizeof(FReplaySessionInfo); }
+		virtual bool IsValid() const override { return true; }
+		virtual const FUniqueNetId& GetSessionId() const override { return *SessionId; }
+		virtual FString ToString() const override { return SessionId->ToString(); }
+		virtual FString ToDebugString() const override { return FString::Printf(TEXT("Replayed session %s"), *SessionId->ToString()); }
+
+	private:
+		FUniqueNetIdRef SessionId;
+	};
+
+	/** Writes the value as its own type, or reads it back into the variant */
+	template <typename ValueType>
+	void SerializeValue(FArchive& Ar, FVariantData& Data, ValueType Value)
+	{
+		if (Ar.IsSaving())
+		{
+			Data.GetValue(Value);
+		}
+		
+		Ar << Value;
+
+		if (Ar.IsLoading())
+		{
+			Data.SetValue(Value);
+		}
+	}
+
+	/** Only the value types the subsystem advertises are kept, anything else is recorded as empty */
+	void SerializeVariantData(FArchive& Ar, FVariantData& Data)
+	{
+		uint8 Type = static_cast<uint8>(Data.GetType());
+		Ar << Type;
+
+		switch (static_cast<EOnlineKeyValuePairDataType::Type>(Type))
+		{
+		case EOnlineKeyValuePairDataType::Int32:	SerializeValue(Ar, Data, int32(0)); break;
+		case EOnlineKeyValuePairDataType::UInt32:	SerializeValue(Ar, Data, uint32(0)); break;
+		case EOnlineKeyValuePairDataType::Int64:	SerializeValue(Ar, Data, int64(0)); break;
+		case EOnlineKeyValuePairDataType::UInt64:	SerializeValue(Ar, Data, uint64(0)); break;
+		case EOnlineKeyValuePairDataType::Float:	SerializeValue(Ar, Data, 0.f); break;
+		case EOnlineKeyValuePairDataType::Double:	SerializeValue(Ar, Data, 0.0); break;
+		case EOnlineKeyValuePairDataType::String:	SerializeValue(Ar, Data, FString()); break;
+		case EOnlineKeyValuePairDataType::Bool:		SerializeValue(Ar, Data, false); break;
+		default:
+			if (Ar.IsLoading())
+			{
+				Data.Empty();
+			}
+			break;
+		}
+	}
+}
+
+#pragma region Recorded Session
+
+FMssRecordedSession FMssRecordedSession::FromSearchResult(const FOnlineSessionSearchResult& InSearchResult)
+{
+	FMssRecordedSession RecordedSession;
+	RecordedSession.SessionId = InSearchResult.GetSessionIdStr();
+	RecordedSession.OwningUserId = InSearchResult.Session.OwningUserId.IsValid() ? InSearchResult.Session.OwningUserId->ToString() : FString();
+	RecordedSession.OwningUserName = InSearchResult.Session.OwningUserName;
+	RecordedSession.PingInMs = InSearchResult.PingInMs;
+	RecordedSession.NumPublicConnections = InSearchResult.Session.SessionSettings.NumPublicConnections;
+	RecordedSession.NumOpenPublicConnections = InSearchResult.Session.NumOpenPublicConnections;
+	RecordedSession.NumOpenPrivateConnections = InSearchResult.Session.NumOpenPrivateConnections;
+	RecordedSession.bIsLANMatch = InSearchResult.Session.SessionSettings.bIsLANMatch;
+
+	RecordedSession.Settings.Reserve(InSearchResult.Session.SessionSettings.Settings.Num());
+	for (const TPair<FName, FOnlineSessionSetting>& Setting : InSearchResult.Session.SessionSettings.Settings)
+	{
+		RecordedSession.Settings.Add({ Setting.Key, Setting.Value.Data, static_cast<uint8>(Setting.Value.AdvertisementType) });
+	}
+
+	return RecordedSession;
+}
+
+FOnlineSessionSearchResult FMssRecordedSession::ToSearchResult() const
+{
+	FOnlineSessionSearchResult SearchResult;
+	SearchResult.PingInMs = PingInMs;
+	SearchResult.Session.SessionInfo = MakeShared<MssSessionRecording::FReplaySessionInfo>(SessionId);
+	SearchResult.Session.OwningUserName = OwningUserName;
+	SearchResult.Session.NumOpenPublicConnections = NumOpenPublicConnections;
+	SearchResult.Session.NumOpenPrivateConnections = NumOpenPrivateConnections;
+	SearchResult.Session.SessionSettings.NumPublicConnections = NumPublicConnections;
+	SearchResult.Session.SessionSettings.bIsLANMatch = bIsLANMatch;
+
+	if (!OwningUserId.IsEmpty())
+	{
+		SearchResult.Session.OwningUserId = FUniqueNetIdString::Create(OwningUserId, MssSessionRecording::ReplayNetIdType);
+	}
+
+	for (const FSetting& Setting : Settings)
+	{
+		FOnlineSessionSetting& SessionSetting = SearchResult.Session.SessionSettings.Settings.Add(Setting.Key);
+		SessionSetting.Data = Setting.Data;
+		SessionSetting.AdvertisementType = static_cast<EOnlineDataAdvertisementType::Type>(Setting.AdvertisementType);
+	}
+
+	return SearchResult;
+}
+
+FArchive& operator<<(FArchive& Ar, FMssRecordedSession& Session)
+{
+	Ar << Session.SessionId;
+	Ar << Session.OwningUserId;
+	Ar << Session.OwningUserName;
+	Ar << Session.PingInMs;
+	Ar << Session.NumPublicConnections;
+	Ar << Session.NumOpenPublicConnections;
+	Ar << Session.NumOpenPrivateConnections;
+	Ar << Session.bIsLANMatch;
+
+	int32 NumSettings = Session.Settings.Num();
+	Ar << NumSettings;
+
+	if (Ar.IsLoading())
+	{
+		Session.Settings.SetNum(FMath::Max(NumSettings, 0));
+	}
+
+	for (FMssRecordedSession::FSetting& Setting : Session.Settings)
+	{
+		// Keys are stored as plain strings, name indices do not survive the process
+		FString Key = Setting.Key.ToString();
+		Ar << Key;
+		Setting.Key = FName(*Key);
+
+		MssSessionRecording::SerializeVariantData(Ar, Setting.Data);
+		Ar << Setting.AdvertisementType;
+	}
+
+	return Ar;
+}
+
+#pragma endregion Recorded Session
+
+#pragma region Recorded Operation
+
+FArchive& operator<<(FArchive& Ar, FMssRecordedOperation& Operation)
+{
+	uint8 OperationType = static_cast<uint8>(Operation.Operation);
+	Ar << OperationType;
+	Operation.Operation = static_cast<EMssTraceOperation>(OperationType);
+
+	Ar << Operation.IssuedAtSeconds;
+	Ar << Operation.CompletedAtSeconds;
+	Ar << Operation.bWasCancelled;
+	Ar << Operation.bWasSuccessful;
+	Ar << Operation.JoinResult;
+	Ar << Operation.SessionId;
+	Ar << Operation.Results;
+
+	return Ar;
+}
+
+#pragma endregion Recorded Operation
+
+#pragma region Session Recording
+
+bool FMssSessionRecording::SaveToFile(const FString& InPath) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Writer << const_cast<FMssSessionRecording&>(*this);
+
+	return FFileHelper::SaveArrayToFile(Bytes, *InPath);
+}
+
+bool FMssSessionRecording::LoadFromFile(const FString& InPath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *InPath))
+		return false;
+
+	FMemoryReader Reader(Bytes);
+	Reader << *this;
+
+	return !Reader.IsError();
+}
+
+FArchive& operator<<(FArchive& Ar, FMssSessionRecording& Recording)
+{
+	uint32 Magic = MssSessionRecording::FileMagic;
+	int32 Version = MssSessionRecording::FileVersion;
+	Ar << Magic;
+	Ar << Version;
+
+	if (Magic != MssSessionRecording::FileMagic || Version != MssSessionRecording::FileVersion)
+	{
+		Ar.SetError();
+		return Ar;
+	}
+
+	Ar << Recording.RecordedAtUnixTime;
+	Ar << Recording.Operations;
+
+	return Ar;
+}
+
+#pragma endregion Session Recording
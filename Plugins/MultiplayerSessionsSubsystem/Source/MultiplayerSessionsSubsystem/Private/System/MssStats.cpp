@@ -0,0 +1,71 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#include "System/MssStats.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+double FMssStats::GetAverageTimeToJoinSeconds() const
+{
+	return JoinsSucceeded > 0 ? TotalTimeToJoinSeconds / JoinsSucceeded : 0.0;
+}
+
+FString FMssStats::ToJsonString() const
+{
+	const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	JsonObject->SetNumberField(TEXT("searches_issued"), SearchesIssued);
+	JsonObject->SetNumberField(TEXT("search_results_received"), SearchResultsReceived);
+	JsonObject->SetNumberField(TEXT("widgets_created"), WidgetsCreated);
+	JsonObject->SetNumberField(TEXT("widgets_recycled"), WidgetsRecycled);
+	JsonObject->SetNumberField(TEXT("joins_attempted"), JoinsAttempted);
+	JsonObject->SetNumberField(TEXT("joins_succeeded"), JoinsSucceeded);
+	JsonObject->SetNumberField(TEXT("average_time_to_join_seconds"), GetAverageTimeToJoinSeconds());
+	JsonObject->SetNumberField(TEXT("cached_search_results"), CachedSearchResults);
+	JsonObject->SetNumberField(TEXT("search_result_store_bytes"), SearchResultStoreBytes);
+	JsonObject->SetNumberField(TEXT("cached_latencies"), CachedLatencies);
+	JsonObject->SetNumberField(TEXT("active_session_widgets"), ActiveSessionWidgets);
+	JsonObject->SetNumberField(TEXT("indexed_session_keys"), IndexedSessionKeys);
+	JsonObject->SetNumberField(TEXT("pooled_session_widgets"), PooledSessionWidgets);
+
+	FString JsonString;
+	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&JsonString);
+	FJsonSerializer::Serialize(JsonObject, JsonWriter);
+
+	return JsonString;
+}
+
+FString FMssStats::GetCsvHeader()
+{
+	return TEXT("timestamp,searches_issued,search_results_received,widgets_created,widgets_recycled,joins_attempted,joins_succeeded,")
+		TEXT("average_time_to_join_seconds,cached_search_results,search_result_store_bytes,cached_latencies,active_session_widgets,indexed_session_keys,pooled_session_widgets");
+}
+
+FString FMssStats::ToCsvRow() const
+{
+	return FString::Printf(TEXT("%s,%lld,%lld,%lld,%lld,%lld,%lld,%.3f,%d,%lld,%d,%d,%d,%d"),
+		*FDateTime::UtcNow().ToIso8601(), SearchesIssued, SearchResultsReceived, WidgetsCreated, WidgetsRecycled,
+		JoinsAttempted, JoinsSucceeded, GetAverageTimeToJoinSeconds(), CachedSearchResults, SearchResultStoreBytes, CachedLatencies,
+		ActiveSessionWidgets, IndexedSessionKeys, PooledSessionWidgets);
+}
+
+FString FMssStats::ToDisplayString() const
+{
+	return FString::Printf(TEXT(
+		"Searches issued        : %lld\n"
+		"Results received       : %lld\n"
+		"Widgets created        : %lld\n"
+		"Widgets recycled       : %lld\n"
+		"Joins attempted        : %lld\n"
+		"Joins succeeded        : %lld\n"
+		"Average time to join   : %.3fs\n"
+		"Cached search results  : %d\n"
+		"Result store memory    : %lld bytes\n"
+		"Cached latencies       : %d\n"
+		"Active session widgets : %d\n"
+		"Indexed session keys   : %d\n"
+		"Pooled session widgets : %d"),
+		SearchesIssued, SearchResultsReceived, WidgetsCreated, WidgetsRecycled, JoinsAttempted, JoinsSucceeded,
+		GetAverageTimeToJoinSeconds(), CachedSearchResults, SearchResultStoreBytes, CachedLatencies, ActiveSessionWidgets, IndexedSessionKeys, PooledSessionWidgets);
+}
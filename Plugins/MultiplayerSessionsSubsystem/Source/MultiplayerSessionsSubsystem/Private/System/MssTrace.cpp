@@ -0,0 +1,79 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#include "System/MssTrace.h"
+
+#include "ProfilingDebugging/MiscTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(MssChannel)
+
+UE_TRACE_EVENT_BEGIN(Mss, OperationBegin)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, OperationId)
+	UE_TRACE_EVENT_FIELD(uint8, Operation)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Mss, OperationEnd)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, OperationId)
+	UE_TRACE_EVENT_FIELD(uint8, Operation)
+	UE_TRACE_EVENT_FIELD(bool, bWasSuccessful)
+UE_TRACE_EVENT_END()
+
+namespace
+{
+	const TCHAR* GetOperationName(EMssTraceOperation InOperation)
+	{
+		switch (InOperation)
+		{
+		case EMssTraceOperation::CreateSession:	return TEXT("CreateSession");
+		case EMssTraceOperation::FindSessions:	return TEXT("FindSessions");
+		case EMssTraceOperation::JoinSession:	return TEXT("JoinSession");
+		case EMssTraceOperation::DestroySession:	return TEXT("DestroySession");
+		case EMssTraceOperation::StartSession:	return TEXT("StartSession");
+		}
+		return TEXT("Unknown");
+	}
+
+	/** Session operations only run on the game thread */
+	uint32 NextOperationId = 0;
+}
+
+uint32 MssTrace::BeginOperation(EMssTraceOperation InOperation)
+{
+	if (++NextOperationId == 0)
+	{
+		++NextOperationId;
+	}
+	const uint32 OperationId = NextOperationId;
+
+	UE_TRACE_LOG(Mss, OperationBegin, MssChannel)
+		<< OperationBegin.Cycle(FPlatformTime::Cycles64())
+		<< OperationBegin.OperationId(OperationId)
+		<< OperationBegin.Operation(static_cast<uint8>(InOperation));
+
+	if (UE_TRACE_CHANNELEXPR_IS_ENABLED(MssChannel))
+	{
+		TRACE_BOOKMARK(TEXT("Mss %s #%u begin"), GetOperationName(InOperation), OperationId);
+	}
+
+	return OperationId;
+}
+
+void MssTrace::EndOperation(EMssTraceOperation InOperation, uint32& InOutOperationId, bool bWasSuccessful)
+{
+	if (InOutOperationId == 0)
+		return;
+
+	UE_TRACE_LOG(Mss, OperationEnd, MssChannel)
+		<< OperationEnd.Cycle(FPlatformTime::Cycles64())
+		<< OperationEnd.OperationId(InOutOperationId)
+		<< OperationEnd.Operation(static_cast<uint8>(InOperation))
+		<< OperationEnd.bWasSuccessful(bWasSuccessful);
+
+	if (UE_TRACE_CHANNELEXPR_IS_ENABLED(MssChannel))
+	{
+		TRACE_BOOKMARK(TEXT("Mss %s #%u %s"), GetOperationName(InOperation), InOutOperationId, bWasSuccessful ? TEXT("succeeded") : TEXT("failed"));
+	}
+
+	InOutOperationId = 0;
+}
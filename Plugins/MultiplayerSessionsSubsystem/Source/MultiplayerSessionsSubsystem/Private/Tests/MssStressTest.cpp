@@ -0,0 +1,131 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Stress/MssStressRun.h"
+#include "Subsystem/MssSubsystem.h"
+
+namespace MssStressTest
+{
+	/** Operations fired when the test parameters do not say */
+	constexpr int32 DefaultNumOperations = 200;
+
+	/** Seeds run by default, a failing seed can be added here once fixed to keep it covered */
+	const int32 Seeds[] = { 7, 42, 1337 };
+
+	/** @return the session subsystem of the first game or PIE world, null when no game is running */
+	UMssSubsystem* FindMssSubsystem()
+	{
+		if (!GEngine)
+			return nullptr;
+
+		for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+		{
+			if (WorldContext.WorldType != EWorldType::Game && WorldContext.WorldType != EWorldType::PIE)
+				continue;
+
+			if (const UGameInstance* GameInstance = WorldContext.OwningGameInstance)
+			{
+				if (UMssSubsystem* MssSubsystem = GameInstance->GetSubsystem<UMssSubsystem>())
+					return MssSubsystem;
+			}
+		}
+
+		return nullptr;
+	}
+}
+
+/** Starts the run on the running game, it is driven by the timers of the game instance from there */
+DEFINE_LATENT_AUTOMATION_COMMAND_FOUR_PARAMETER(FMssStartStressRunCommand, FAutomationTestBase*, Test, UMssStressRun*, StressRun, int32, NumOperations, int32, Seed);
+
+bool FMssStartStressRunCommand::Update()
+{
+	UMssSubsystem* MssSubsystem = MssStressTest::FindMssSubsystem();
+	if (!MssSubsystem)
+	{
+		Test->AddError(TEXT("No running game with a session subsystem, run the test in PIE or a -game instance"));
+		return true;
+	}
+
+	if (!StressRun->Start(MssSubsystem, NumOperations, Seed))
+	{
+		Test->AddError(TEXT("The stress run could not start, the subsystem is replaying"));
+	}
+
+	return true;
+}
+
+/** Waits for the run to settle and reports its checks */
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FMssWaitForStressRunCommand, FAutomationTestBase*, Test, UMssStressRun*, StressRun);
+
+bool FMssWaitForStressRunCommand::Update()
+{
+	// The game ended under the run, its timers are gone with the game instance
+	if (StressRun->IsRunning() && !MssStressTest::FindMssSubsystem())
+	{
+		StressRun->Abort();
+	}
+
+	if (StressRun->IsRunning())
+		return false;
+
+	if (!StressRun->HasPassed() && !StressRun->GetFailureReason().IsEmpty())
+	{
+		Test->AddError(FString::Printf(TEXT("Stress run failed, %s"), *StressRun->GetFailureReason()));
+	}
+
+	if (!StressRun->GetRecordingPath().IsEmpty())
+	{
+		Test->AddInfo(FString::Printf(TEXT("Recorded to %s, replay it with mss.replay"), *StressRun->GetRecordingPath()));
+	}
+
+	StressRun->RemoveFromRoot();
+
+	return true;
+}
+
+/**
+ * Fires a seeded random sequence of session operations at the subsystem over LAN and checks every one is answered, see UMssStressRun
+ * Needs a running game, each parameter is "<seed> [operations]"
+ ******************************************************************************************/
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FMssStressTest, "MultiplayerSessionsSubsystem.Stress.SessionStateTransitions",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::StressFilter)
+
+void FMssStressTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const int32 Seed : MssStressTest::Seeds)
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("Seed %d"), Seed));
+		OutTestCommands.Add(FString::Printf(TEXT("%d %d"), Seed, MssStressTest::DefaultNumOperations));
+	}
+}
+
+bool FMssStressTest::RunTest(const FString& Parameters)
+{
+	TArray<FString> Arguments;
+	Parameters.ParseIntoArrayWS(Arguments);
+
+	if (Arguments.IsEmpty() || !Arguments[0].IsNumeric())
+	{
+		AddError(FString::Printf(TEXT("Expected \"<seed> [operations]\", got \"%s\""), *Parameters));
+		return false;
+	}
+
+	const int32 Seed = FCString::Atoi(*Arguments[0]);
+	const int32 NumOperations = Arguments.Num() > 1 ? FCString::Atoi(*Arguments[1]) : MssStressTest::DefaultNumOperations;
+
+	// Rooted until the wait command has reported, latent commands do not keep objects alive
+	UMssStressRun* StressRun = NewObject<UMssStressRun>();
+	StressRun->AddToRoot();
+
+	ADD_LATENT_AUTOMATION_COMMAND(FMssStartStressRunCommand(this, StressRun, NumOperations, Seed));
+	ADD_LATENT_AUTOMATION_COMMAND(FMssWaitForStressRunCommand(this, StressRun));
+
+	return true;
+}
+
+#endif
@@ -4,21 +4,21 @@
 
 #include "OnlineSessionSettings.h"
 #include "Widgets/MssSessionDataWidget.h"
+#include "Widgets/MssSessionListScrollBox.h"
+#include "Subsystem/MssSessionListModel.h"
+#include "Engine/AssetManager.h"
 #include "Engine/GameInstance.h"
 #include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
 #include "Online/OnlineSessionNames.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "System/MssLogger.h"
-#include "UObject/ConstructorHelpers.h"
 
 UMssHUD::UMssHUD(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	{
-		static ConstructorHelpers::FClassFinder<UUserWidget> Asset(TEXT("/MultiplayerSessionsSubsystem/Blueprints/Widgets/WBP_SessionData_Mss.WBP_SessionData_Mss_C"));
-		if (Asset.Succeeded())
-			SessionDataWidgetClass = Asset.Class;
-	}
+	// Only the path is stored, nothing is loaded until the session list is opened
+	SessionDataWidgetClass = TSoftClassPtr<UMssSessionDataWidget>(FSoftObjectPath(TEXT("/MultiplayerSessionsSubsystem/Blueprints/Widgets/WBP_SessionData_Mss.WBP_SessionData_Mss_C")));
 }
 
 bool UMssHUD::Initialize()
@@ -50,6 +50,25 @@ bool UMssHUD::Initialize()
 	MssSubsystem->MultiplayerSessionsOnJoinSessionsComplete.AddUObject(this, &ThisClass::OnSessionJoinedCallback);
 	MssSubsystem->MultiplayerSessionsOnDestroySessionComplete.AddDynamic(this, &ThisClass::OnSessionDestroyedCallback);
 	MssSubsystem->MultiplayerSessionsOnStartSessionComplete.AddDynamic(this, &ThisClass::OnSessionStartedCallback);
+
+	if (UMssSessionListModel* SessionListModel = MssSubsystem->GetSessionListModel())
+	{
+		SessionListView = SessionListModel->CreateView();
+		SessionListView->FilterProvider.BindUObject(this, &ThisClass::GetCurrentSessionsFilter);
+		SessionListView->SetSortKey(SessionSortKey);
+		SessionListView->SetPingSortBucketInMs(PingSortBucketInMs);
+		SessionListView->SetPage(0, SessionsPageSize);
+		SessionListView->OnViewChanged.AddUObject(this, &ThisClass::OnSessionListViewChanged);
+
+		SessionListModel->OnSearchFailed.AddUObject(this, &ThisClass::OnSessionListSearchFailed);
+	}
+
+	// A host that refused the last join sent this client back to the menu, tell the player why
+	const FString JoinRejectReason = MssSubsystem->ConsumeJoinRejectReason();
+	if (!JoinRejectReason.IsEmpty())
+	{
+		ShowMessage(FString::Printf(TEXT("Could not join: %s"), *JoinRejectReason), true);
+	}
 	
 	return true;
 }
@@ -62,20 +81,11 @@ void UMssHUD::HostGame(const FTempCustomSessionSettings& InSessionSettings)
 
 	if (GetMssSubsystem())
 	{
+		MssSubsystem->PreloadMap(LobbyMapPath);
 		MssSubsystem->CreateSession(InSessionSettings);
 	}
 }
 
-void UMssHUD::FindGame()
-{
-	LOG_INFO(TEXT("Called"));
-	
-	if (GetMssSubsystem())
-	{
-		MssSubsystem->FindSessions();
-	}
-}
-
 void UMssHUD::EnterCode(const FText& InSessionCode)
 {
 	LOG_INFO(TEXT("Called session Code Entered : %s"), *InSessionCode.ToString());
@@ -93,6 +103,7 @@ void UMssHUD::EnterCode(const FText& InSessionCode)
 	
 	if (GetMssSubsystem())
 	{
+		MssSubsystem->PreloadMap(LobbyMapPath);
 		MssSubsystem->FindSessions();
 	}
 }
@@ -106,22 +117,31 @@ void UMssHUD::OnSessionCreatedCallback(bool bWasSuccessful)
 	if (!bWasSuccessful)
 	{
 		ShowMessage(FString("Failed to Create Session"), true);
+
+		if (GetMssSubsystem())
+		{
+			MssSubsystem->ReleasePreloadedMap();
+		}
+		
 		return;
 	}
 
-	const FString TravelPath = LobbyMapPath + FString("?listen");
-	LOG_INFO(TEXT("Server travel to path: %s"), *TravelPath);
-		
-	if (UWorld* World = GetWorld())
+	if (GetMssSubsystem())
 	{
-		World->ServerTravel(TravelPath);
+		MssSubsystem->ServerTravelToLobby(LobbyMapPath);
 	}
 }
 
 void UMssHUD::OnSessionsFoundCallback(const TArray<FOnlineSessionSearchResult>& SessionResults, bool bWasSuccessful)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssHUD::OnSessionsFoundCallback);
+	
 	LOG_INFO(TEXT("Session found : %s"), bWasSuccessful ? TEXT("Success") : TEXT("Failed"));
 	
+	// The session list is refreshed by its view, only joins by code are handled here
+	if (!bJoinSessionViaCode)
+		return;
+	
 	if (!GetMssSubsystem())
 	{		
 		LOG_ERROR(TEXT("UMssHUD::OnSessionsFoundCallback MultiplayerSessionsSubsystem is INVALID"));
@@ -136,20 +156,14 @@ void UMssHUD::OnSessionsFoundCallback(const TArray<FOnlineSessionSearchResult>&
 	if (!bWasSuccessful)
 	{
 		bJoinSessionViaCode = false;
+		MssSubsystem->ReleasePreloadedMap();
 		ShowMessage(FString("Failed to Find Session"), true);
 		SetFindSessionsThrobberVisibility(ESlateVisibility::Visible);
 		
 		return;
 	}
 
-	if (bJoinSessionViaCode)
-	{
-		JoinSessionViaSessionCode(SessionResults);
-	}
-	else
-	{
-		UpdateSessionsList(SessionResults);
-	}
+	JoinSessionViaSessionCode(SessionResults);
 }
 
 void UMssHUD::OnSessionJoinedCallback(EOnJoinSessionCompleteResult::Type Result)
@@ -180,36 +194,25 @@ void UMssHUD::OnSessionJoinedCallback(EOnJoinSessionCompleteResult::Type Result)
 	{
 		ShowMessage(FString::Printf(TEXT("%s"), LexToString(Result)), true);
 		bJoinSessionViaCode = false;
+
+		// Joins refused before reaching the backend do not release the preload themselves
+		if (GetMssSubsystem())
+		{
+			MssSubsystem->ReleasePreloadedMap();
+		}
 		
 		return;
 	}
 	
-	const IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
-	if (!OnlineSubsystem)
+	if (!GetMssSubsystem() || !MssSubsystem->ClientTravelToSession())
 	{
-		LOG_ERROR(TEXT("OnlineSubsystem is NULL"));
-	}
-	
-	const IOnlineSessionPtr SessionInterface = OnlineSubsystem->GetSessionInterface();
-	if (!SessionInterface.IsValid())
-	{
-		LOG_ERROR(TEXT("SessionInterface is INVALID"));
-	}
-	
-	if (FString AddressOfSessionToJoin; 
-			SessionInterface->GetResolvedConnectString(NAME_GameSession, AddressOfSessionToJoin))
-	{
-		if (APlayerController* PlayerController = GetGameInstance()->GetFirstLocalPlayerController())
-		{
-			PlayerController->ClientTravel(AddressOfSessionToJoin, ETravelType::TRAVEL_Absolute);	
-		}
-	}
-	else
-	{
-		LOG_ERROR(TEXT("Failed to find the address of the session to join"));
-		
 		ShowMessage(FString("Failed to Join Session"), true);
 		bJoinSessionViaCode = false;
+
+		if (MssSubsystem)
+		{
+			MssSubsystem->ReleasePreloadedMap();
+		}
 	}
 }
 
@@ -254,108 +257,126 @@ void UMssHUD::JoinSessionViaSessionCode(const TArray<FOnlineSessionSearchResult>
 	ShowMessage(FString::Printf(TEXT("Wrong Session Code Entered: %s"), *SessionCodeToJoin), true);
 	
 	bJoinSessionViaCode = false;
+
+	if (GetMssSubsystem())
+	{
+		MssSubsystem->ReleasePreloadedMap();
+	}
 }
 
-void UMssHUD::UpdateSessionsList(const TArray<FOnlineSessionSearchResult>& Results)
+void UMssHUD::UpdateSessionsList(const TArray<FMssSessionListEntry>& InRows)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssHUD::UpdateSessionsList);
+	
 	LOG_INFO(TEXT("Called"));
 
-	TSet<FString> NewSessionKeys;
-	bool bAnySessionExists = false;
+	// Rows are listed once the widget class has streamed in, the throbber stays up meanwhile
+	if (SessionDataWidgetClassHandle.IsValid() && SessionDataWidgetClassHandle->IsLoadingInProgress())
+		return;
 
-	// Filter settings
-	const auto [MapName, GameMode, Players] = GetCurrentSessionsFilter();
-	const bool bShowAllMap = MapName == "Any";
-	const bool bShowAllGameMode = GameMode == "Any";
-	const bool bShowAllPlayers = Players == "Any";
+	bool bListChanged = false;
 
-	// --- FIRST PASS: Add/update only filtered sessions ---
-	for (const FOnlineSessionSearchResult& Result : Results)
+	// --- FIRST PASS: REMOVE rows the view no longer lists ---
+	TSet<FString> NewSessionIds;
+	NewSessionIds.Reserve(InRows.Num());
+	for (const FMssSessionListEntry& Row : InRows)
 	{
-		if (Result.Session.NumOpenPublicConnections <= 0)
-			continue;
-
-		FTempCustomSessionSettings CurrentSessionSettings;
-		Result.Session.SessionSettings.Get(SETTING_MAPNAME, CurrentSessionSettings.MapName);
-		Result.Session.SessionSettings.Get(SETTING_GAMEMODE, CurrentSessionSettings.GameMode);
-		Result.Session.SessionSettings.Get(SETTING_NUMPLAYERSREQUIRED, CurrentSessionSettings.Players);
+		NewSessionIds.Add(Row.SessionId);
+	}
 
-		if (!bShowAllMap && CurrentSessionSettings.MapName != MapName)
-			continue;
-		
-		if (!bShowAllGameMode && CurrentSessionSettings.GameMode != GameMode)
-			continue;
-		
-		if (!bShowAllPlayers && CurrentSessionSettings.Players != Players)
+	for (auto It = ActiveSessionWidgets.CreateIterator(); It; ++It)
+	{
+		if (NewSessionIds.Contains(It.Key()))
 			continue;
-		
-		// Session matches the filter → handle it
-		const FString Key = Result.GetSessionIdStr();
-		NewSessionKeys.Add(Key);
 
-		// --- UPDATE EXISTING WIDGET ---
-		if (UMssSessionDataWidget** ExistingWidgetPtr = ActiveSessionWidgets.Find(Key))
+		ReleaseSessionDataWidget(It.Value());
+		It.RemoveCurrent();
+		bListChanged = true;
+	}
+
+	// --- SECOND PASS: ADD new rows, UPDATE rows only when what they display has changed ---
+	TArray<UMssSessionDataWidget*> OrderedWidgets;
+	OrderedWidgets.Reserve(InRows.Num());
+	
+	for (const FMssSessionListEntry& Row : InRows)
+	{
+		if (UMssSessionDataWidget** ExistingWidgetPtr = ActiveSessionWidgets.Find(Row.SessionId))
 		{
-			(*ExistingWidgetPtr)->SetSessionInfo(Result, CurrentSessionSettings);
-			bAnySessionExists = true;
+			if (!(*ExistingWidgetPtr)->IsDisplaying(Row.Fingerprint))
+			{
+				(*ExistingWidgetPtr)->SetSessionInfo(Row);
+				bListChanged = true;
+			}
+			OrderedWidgets.Add(*ExistingWidgetPtr);
 			continue;
 		}
 
-		// --- ADD NEW WIDGET ---
-		if (!SessionDataWidgetClass)
+		if (!SessionDataWidgetClass.Get())
 		{
 			LOG_ERROR(TEXT("SessionDataWidgetClass is NULL!"));
 			return;
 		}
 
-		UMssSessionDataWidget* NewWidget = CreateWidget<UMssSessionDataWidget>(GetWorld(), SessionDataWidgetClass);
-		NewWidget->SetSessionInfo(Result, CurrentSessionSettings);
+		UMssSessionDataWidget* NewWidget = AcquireSessionDataWidget();
+		NewWidget->SetSessionInfo(Row);
 		NewWidget->SetMssHUDRef(this);
 
-		AddSessionDataWidget(NewWidget);
-		ActiveSessionWidgets.Add(Key, NewWidget);
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(UMssHUD::AddSessionDataWidget);
+			AddSessionDataWidget(NewWidget);
+		}
 
-		bAnySessionExists = true;
+		// The blueprint may list the row in a scroll box of its own, the sorted one takes it over
+		if (SessionsScrollBox && NewWidget->GetParent() != SessionsScrollBox)
+		{
+			SessionsScrollBox->AddChild(NewWidget);
+		}
+		ActiveSessionWidgets.Add(Row.SessionId, NewWidget);
+		OrderedWidgets.Add(NewWidget);
+		
+		bListChanged = true;
 	}
 
-	// --- SECOND PASS: REMOVE widgets NOT in filtered set ---
-	for (const FString& CurrentKey : LastSessionKeys)
+	// --- THIRD PASS: MOVE rows to the order of the view, new rows were appended ---
+	if (SessionsScrollBox)
 	{
-		if (NewSessionKeys.Contains(CurrentKey))
-			continue;
-
-		if (UMssSessionDataWidget** WidgetPtr = ActiveSessionWidgets.Find(CurrentKey))
+		for (int32 Index = 0; Index < OrderedWidgets.Num(); ++Index)
 		{
-			if (UMssSessionDataWidget* Widget = *WidgetPtr)
-				Widget->RemoveFromParent();
+			if (SessionsScrollBox->GetChildIndex(OrderedWidgets[Index]) != Index)
+			{
+				SessionsScrollBox->MoveRow(Index, OrderedWidgets[Index]);
+				bListChanged = true;
+			}
 		}
 
-		ActiveSessionWidgets.Remove(CurrentKey);
+		// A steady list leaves the Slate slots untouched
+		if (bListChanged)
+		{
+			SessionsScrollBox->SynchronizeSlateOrder();
+		}
 	}
 
-	LastSessionKeys = MoveTemp(NewSessionKeys);
+	ReportWidgetStats();
 
 	// UI status messaging
-	if (bAnySessionExists)
-	{
-		SetFindSessionsThrobberVisibility(ESlateVisibility::Hidden);
-	}
-	else
-	{
-		SetFindSessionsThrobberVisibility(ESlateVisibility::Visible);
-	}
+	SetFindSessionsThrobberVisibility(InRows.IsEmpty() ? ESlateVisibility::Visible : ESlateVisibility::Hidden);
+}
 
-	// Auto-refresh logic
-	if (bCanFindNewSessions)
-	{
-		if (!IsValid(this) || !GetWorld() || GetWorld()->bIsTearingDown)
-		{
-			LOG_INFO(TEXT("UpdateSessionsList aborted – world is tearing down"));
-			return;
-		}
+void UMssHUD::OnSessionListViewChanged()
+{
+	if (!bCanFindNewSessions || !SessionListView)
+		return;
 
-		FindGame();
-	}
+	UpdateSessionsList(SessionListView->GetRows());
+}
+
+void UMssHUD::OnSessionListSearchFailed()
+{
+	if (!bCanFindNewSessions)
+		return;
+
+	ShowMessage(FString("Failed to Find Session"), true);
+	SetFindSessionsThrobberVisibility(ESlateVisibility::Visible);
 }
 
 void UMssHUD::JoinTheGivenSession(FOnlineSessionSearchResult& InSessionToJoin)
@@ -372,8 +393,22 @@ void UMssHUD::JoinTheGivenSession(FOnlineSessionSearchResult& InSessionToJoin)
 
 	if (GetMssSubsystem())
 	{
-	MssSubsystem->JoinSessions(InSessionToJoin);
+		MssSubsystem->PreloadMap(LobbyMapPath);
+		MssSubsystem->JoinSessions(InSessionToJoin);
+	}
+}
+
+void UMssHUD::JoinSessionById(const FString& InSessionId)
+{
+	FOnlineSessionSearchResult SessionToJoin;
+	if (!GetMssSubsystem() || !MssSubsystem->GetSearchResultById(InSessionId, SessionToJoin))
+	{
+		LOG_WARNING(TEXT("Session %s is no longer in the search results"), *InSessionId);
+		ShowMessage(FString("Session is no longer available"), true);
+		return;
 	}
+
+	JoinTheGivenSession(SessionToJoin);
 }
 
 FText UMssHUD::OnEnteredSessionCodeChanged(const FText& InCode)
@@ -405,6 +440,17 @@ FText UMssHUD::OnEnteredSessionCodeChanged(const FText& InCode)
 	return InCode;
 }
 
+void UMssHUD::SetLanMode(bool bInUseLanMode)
+{
+	LOG_INFO(TEXT("Called LAN mode : %s"), bInUseLanMode ? TEXT("enabled") : TEXT("disabled"));
+	
+	if (!GetMssSubsystem() || MssSubsystem->IsLanMode() == bInUseLanMode)
+		return;
+
+	// The shared session list is emptied and searches the other backend right away
+	MssSubsystem->SetLanMode(bInUseLanMode);
+}
+
 void UMssHUD::StartFindingSessions()
 {
 	LOG_INFO(TEXT("Called"));
@@ -413,13 +459,21 @@ void UMssHUD::StartFindingSessions()
 	
 	bCanFindNewSessions = true;
 	
-	ActiveSessionWidgets.Empty();
-	
-	LastSessionKeys.Empty();
+	ReleaseAllSessionDataWidgets();
 	
 	SetFindSessionsThrobberVisibility(ESlateVisibility::Visible);
 	
-	FindGame();
+	// Streams in while the first search runs
+	LoadSessionDataWidgetClass();
+	
+	if (!GetMssSubsystem() || !MssSubsystem->GetSessionListModel() || !SessionListView)
+		return;
+
+	MssSubsystem->GetSessionListModel()->AddConsumer(this);
+
+	// Sessions found for other consumers are listed right away, the filter may also have changed since the last time
+	SessionListView->Refresh();
+	UpdateSessionsList(SessionListView->GetRows());
 }
 
 void UMssHUD::StopFindingSessions()
@@ -429,14 +483,126 @@ void UMssHUD::StopFindingSessions()
 	ClearSessionsScrollBox();
 		
 	bCanFindNewSessions = false;
+
+	if (GetMssSubsystem() && MssSubsystem->GetSessionListModel())
+	{
+		MssSubsystem->GetSessionListModel()->RemoveConsumer(this);
+	}
 	
-	ActiveSessionWidgets.Empty();
-	
-	LastSessionKeys.Empty();
+	ReleaseAllSessionDataWidgets();
 	
 	SetFindSessionsThrobberVisibility(ESlateVisibility::Visible);
 }
 
+void UMssHUD::LoadSessionDataWidgetClass()
+{
+	if (SessionDataWidgetClassHandle.IsValid() || SessionDataWidgetClass.IsNull())
+		return;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssHUD::LoadSessionDataWidgetClass);
+
+	LOG_INFO(TEXT("Streaming in %s"), *SessionDataWidgetClass.ToString());
+
+	SessionDataWidgetClassHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(SessionDataWidgetClass.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnSessionDataWidgetClassLoaded));
+}
+
+void UMssHUD::OnSessionDataWidgetClassLoaded()
+{
+	if (!SessionDataWidgetClass.Get())
+	{
+		LOG_ERROR(TEXT("Could not load %s"), *SessionDataWidgetClass.ToString());
+		return;
+	}
+
+	if (bCanFindNewSessions && SessionListView)
+	{
+		UpdateSessionsList(SessionListView->GetRows());
+	}
+}
+
+UMssSessionDataWidget* UMssHUD::AcquireSessionDataWidget()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssHUD::AcquireSessionDataWidget);
+	
+	if (!SessionDataWidgetPool.IsEmpty())
+	{
+		if (GetMssSubsystem())
+		{
+			++MssSubsystem->GetStats().WidgetsRecycled;
+		}
+		
+		return SessionDataWidgetPool.Pop(EAllowShrinking::No);
+	}
+
+	if (GetMssSubsystem())
+	{
+		++MssSubsystem->GetStats().WidgetsCreated;
+	}
+	
+	return CreateWidget<UMssSessionDataWidget>(GetWorld(), SessionDataWidgetClass.Get());
+}
+
+void UMssHUD::ReleaseSessionDataWidget(UMssSessionDataWidget* InSessionDataWidget)
+{
+	if (!IsValid(InSessionDataWidget))
+		return;
+
+	InSessionDataWidget->RemoveFromParent();
+
+	if (SessionDataWidgetPool.Num() < MaxPooledSessionDataWidgets)
+	{
+		SessionDataWidgetPool.Add(InSessionDataWidget);
+	}
+}
+
+void UMssHUD::ReleaseAllSessionDataWidgets()
+{
+	for (const TPair<FString, UMssSessionDataWidget*>& ActiveSessionWidget : ActiveSessionWidgets)
+	{
+		ReleaseSessionDataWidget(ActiveSessionWidget.Value);
+	}
+
+	ActiveSessionWidgets.Empty();
+
+	ReportWidgetStats();
+}
+
+void UMssHUD::ReportWidgetStats()
+{
+	if (!GetMssSubsystem())
+		return;
+
+	FMssStats& Stats = MssSubsystem->GetStats();
+	Stats.ActiveSessionWidgets = ActiveSessionWidgets.Num();
+	Stats.PooledSessionWidgets = SessionDataWidgetPool.Num();
+}
+
+#pragma region Sorted Session List
+
+void UMssHUD::SetSessionSortKey(EMssSessionSortKey InSessionSortKey)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssHUD::SetSessionSortKey);
+	
+	SessionSortKey = InSessionSortKey;
+
+	// The view broadcasts the reordered rows, UpdateSessionsList moves them in place
+	if (SessionListView)
+	{
+		SessionListView->SetSortKey(SessionSortKey);
+	}
+}
+
+void UMssHUD::SetSessionsPage(int32 InPageIndex)
+{
+	if (SessionListView)
+	{
+		SessionListView->SetPage(InPageIndex, SessionsPageSize);
+	}
+}
+
+#pragma endregion Sorted Session List
+
 TObjectPtr<UMssSubsystem> UMssHUD::GetMssSubsystem()
 {
 	if (IsValid(MssSubsystem))
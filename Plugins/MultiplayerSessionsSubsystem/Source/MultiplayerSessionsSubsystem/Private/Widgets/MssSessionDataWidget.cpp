@@ -4,6 +4,7 @@
 
 #include "Components/TextBlock.h"
 #include "Components/Button.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "System/MssLogger.h"
 #include "Widgets/MssHUD.h"
 
@@ -26,17 +27,26 @@ void UMssSessionDataWidget::OnJoinSessionButtonClicked()
 		return;
 	}
 	
-	MssHUDRef->JoinTheGivenSession(SessionSearchResultRef);
+	MssHUDRef->JoinSessionById(SessionId);
 }
 
-void UMssSessionDataWidget::SetSessionInfo(const FOnlineSessionSearchResult& InSessionSearchResultRef, 
-	const FTempCustomSessionSettings& SessionSettings)
+void UMssSessionDataWidget::SetSessionInfo(const FMssSessionListEntry& InEntry)
 {
-	SessionSearchResultRef = InSessionSearchResultRef;
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSessionDataWidget::SetSessionInfo);
 	
-	MapName->SetText(FText::FromString(SessionSettings.MapName));
-	Players->SetText(FText::FromString(SessionSettings.Players));
-	GameMode->SetText(FText::FromString(SessionSettings.GameMode));
+	SessionId = InEntry.SessionId;
+	DisplayedFingerprint = InEntry.Fingerprint;
+	
+	MapName->SetText(FText::FromString(InEntry.MapName));
+	Players->SetText(FText::FromString(InEntry.Players));
+	GameMode->SetText(FText::FromString(InEntry.GameMode));
+
+	if (Ping)
+	{
+		Ping->SetText(InEntry.PingInMs >= MAX_QUERY_PING
+			? FText::FromString(TEXT("-"))
+			: FText::AsNumber(InEntry.PingInMs));
+	}
 }
 
 void UMssSessionDataWidget::SetMssHUDRef(UMssHUD* InMssHUD)
@@ -0,0 +1,51 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#include "Widgets/MssSessionListScrollBox.h"
+
+#include "Components/ScrollBoxSlot.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Widgets/Layout/SScrollBox.h"
+
+void UMssSessionListScrollBox::MoveRow(int32 InIndex, UWidget* InRow)
+{
+	const int32 CurrentIndex = GetChildIndex(InRow);
+	if (CurrentIndex == INDEX_NONE || CurrentIndex == InIndex)
+		return;
+
+	ShiftChild(InIndex, InRow);
+
+	const int32 MovedIndex = FMath::Min(CurrentIndex, InIndex);
+	FirstMovedIndex = FirstMovedIndex == INDEX_NONE ? MovedIndex : FMath::Min(FirstMovedIndex, MovedIndex);
+}
+
+void UMssSessionListScrollBox::SynchronizeSlateOrder()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMssSessionListScrollBox::SynchronizeSlateOrder);
+	
+	if (FirstMovedIndex == INDEX_NONE)
+		return;
+
+	const int32 FirstIndex = FirstMovedIndex;
+	FirstMovedIndex = INDEX_NONE;
+
+	// Not constructed yet, the Slate side is built in slot order when it is
+	if (!MyScrollBox.IsValid())
+		return;
+
+	// Slate slots can only be appended, so the rows from the first moved one on are taken out and appended back in order
+	for (int32 Index = FirstIndex; Index < Slots.Num(); ++Index)
+	{
+		if (Slots[Index] && Slots[Index]->Content)
+		{
+			MyScrollBox->RemoveSlot(Slots[Index]->Content->TakeWidget());
+		}
+	}
+	
+	for (int32 Index = FirstIndex; Index < Slots.Num(); ++Index)
+	{
+		if (UScrollBoxSlot* ScrollBoxSlot = Cast<UScrollBoxSlot>(Slots[Index]))
+		{
+			ScrollBoxSlot->BuildSlot(MyScrollBox.ToSharedRef());
+		}
+	}
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineBeaconClient.h"
+#include "MssBeaconClient.generated.h"
+
+/**
+ * Answer of the host to a reservation request
+ */
+UENUM()
+enum class EMssReservationResult : uint8
+{
+	/** A slot is held for the party until it logs in or the reservation times out */
+	Accepted,
+	/** Players plus pending reservations already fill the session */
+	SessionFull,
+	/** The host is not running the session the client asked for */
+	SessionMismatch,
+	/** The host did not answer in time */
+	TimedOut,
+	/** The beacon connection could not be established */
+	ConnectionFailed
+};
+
+DECLARE_DELEGATE_OneParam(FMssOnReservationResponse, EMssReservationResult Result);
+/** Round trip in milliseconds, INDEX_NONE when the host could not be reached */
+DECLARE_DELEGATE_OneParam(FMssOnPingMeasured, int32 RoundTripMs);
+
+/**
+ * Lightweight beacon connection from a client to a session host
+ * Lets the client reserve a slot before running the session join and the map travel
+ * Also used to measure the round trip to a host before choosing which session to join
+ ******************************************************************************************/
+UCLASS(Transient, NotPlaceable)
+class MULTIPLAYERSESSIONSSUBSYSTEM_API AMssBeaconClient : public AOnlineBeaconClient
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Connects to the host beacon and asks it to hold slots for the party once connected
+	 *
+	 * @param InConnectInfo: Beacon address of the host resolved from the search result
+	 * @param InSessionKey: Session code the client expects the host to be running
+	 * @param InPlayerId: Id of the party leader, the reservation is consumed when this player logs in
+	 * @param InPartySize: Number of slots to hold
+	 * @return true if the connection attempt has started, the answer comes through OnReservationResponse
+	 */
+	bool RequestReservation(const FString& InConnectInfo, const FString& InSessionKey, const FUniqueNetIdRepl& InPlayerId, int32 InPartySize);
+
+	/** Fired once on the client with the answer of the host or the reason no answer came */
+	FMssOnReservationResponse OnReservationResponse;
+
+	/**
+	 * Connects to the host beacon and measures one request/answer round trip once connected
+	 *
+	 * @param InConnectInfo: Beacon address of the host resolved from the search result
+	 * @return true if the connection attempt has started, the result comes through OnPingMeasured
+	 */
+	bool RequestPing(const FString& InConnectInfo);
+
+	/** Fired once on the client with the measured round trip */
+	FMssOnPingMeasured OnPingMeasured;
+
+	//~ Begin AOnlineBeaconClient Interface
+	virtual void OnConnected() override;
+	virtual void OnFailure() override;
+	//~ End AOnlineBeaconClient Interface
+
+protected:
+	/** Client to host, asks for the reservation after the beacon connection is up */
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerRequestReservation(const FString& InSessionKey, const FUniqueNetIdRepl& InPlayerId, int32 InPartySize);
+
+	/** Host to client, answer of the reservation request */
+	UFUNCTION(Client, Reliable)
+	void ClientReservationResponse(EMssReservationResult Result);
+
+	/** Client to host, start of a round trip measurement */
+	UFUNCTION(Server, Reliable)
+	void ServerPing();
+
+	/** Host to client, end of a round trip measurement */
+	UFUNCTION(Client, Reliable)
+	void ClientPong();
+
+private:
+	/** What the client asks for once the connection is established */
+	enum class EMssBeaconRequest : uint8
+	{
+		None,
+		Reservation,
+		Ping
+	};
+	
+	EMssBeaconRequest PendingRequest = EMssBeaconRequest::None;
+	
+	/** Opens the beacon connection for the given request */
+	bool ConnectForRequest(const FString& InConnectInfo, EMssBeaconRequest InRequest);
+
+	/** Fires the response delegate only once, later answers are ignored */
+	void CompleteReservation(EMssReservationResult Result);
+
+	/** Fires the ping delegate only once, later answers are ignored */
+	void CompletePing(int32 RoundTripMs);
+	
+	/** Request data sent once the connection is established */
+	FString PendingSessionKey;
+	FUniqueNetIdRepl PendingPlayerId;
+	int32 PendingPartySize = 1;
+
+	/** Time ServerPing was sent at */
+	double PingSentAtSeconds = 0.0;
+
+	/** True once the delegate of the pending request has been fired */
+	bool bRequestCompleted = false;
+};
@@ -0,0 +1,69 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineBeaconHostObject.h"
+#include "Beacons/MssBeaconClient.h"
+#include "MssBeaconHostObject.generated.h"
+
+class AGameModeBase;
+class APlayerController;
+
+/**
+ * Host side of the reservation beacon
+ * Holds slots for clients that are about to join so that full or mismatched hosts reject them before they travel
+ ******************************************************************************************/
+UCLASS(Transient, NotPlaceable, Config = Game)
+class MULTIPLAYERSESSIONSSUBSYSTEM_API AMssBeaconHostObject : public AOnlineBeaconHostObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Default constructor */
+	AMssBeaconHostObject();
+
+	/**
+	 * Checks the request against the live session and holds the slots when there is room
+	 * 
+	 * @param InSessionKey: Session code the client expects
+	 * @param InPlayerId: Party leader the reservation belongs to
+	 * @param InPartySize: Number of slots requested
+	 * @return Result to send back to the client
+	 */
+	EMssReservationResult ProcessReservationRequest(const FString& InSessionKey, const FUniqueNetIdRepl& InPlayerId, int32 InPartySize);
+
+	/** @return the number of slots currently held by unexpired reservations that have not logged in yet */
+	int32 GetNumReservedSlots() const;
+
+	/** @return the party size of the unexpired reservation held by the given player, 0 when it holds none */
+	int32 GetReservedPartySize(const FUniqueNetIdRepl& InPlayerId) const;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/** A held slot group waiting for its leader to log in */
+	struct FMssReservation
+	{
+		FUniqueNetIdRepl PlayerId;
+		int32 PartySize = 1;
+		double ExpiresAtSeconds = 0.0;
+	};
+
+	/** Seconds a reservation is held for a client that never logs in */
+	UPROPERTY(Config)
+	float ReservationLifetimeInSeconds = 30.f;
+
+	/** Reservations that have neither been consumed nor expired */
+	TArray<FMssReservation> Reservations;
+
+	/** Releases the reservation of the player that has just logged in */
+	void OnGameModePostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer);
+	FDelegateHandle GameModePostLoginDelegateHandle;
+
+	/** Drops every reservation whose lifetime has run out */
+	void PruneExpiredReservations();
+	FTimerHandle PruneReservationsTimerHandle;
+};
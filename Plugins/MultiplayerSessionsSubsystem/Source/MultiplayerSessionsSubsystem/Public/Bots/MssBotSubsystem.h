@@ -0,0 +1,127 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Interfaces/OnlineSessionInterface.h"
+#include "MssBotSubsystem.generated.h"
+
+class UMssSubsystem;
+
+/** A step of the bot script */
+UENUM()
+enum class EMssBotStep : uint8
+{
+	/** Searches until at least one open session is found */
+	Find,
+	/** Joins the lowest latency session of the last search and travels to it */
+	Join,
+	/** Sends synthetic move and look input to the possessed pawn for the given seconds */
+	Play,
+	/** Destroys the joined session and returns to the entry map */
+	Destroy,
+	/** Does nothing for the given seconds */
+	Wait
+};
+
+/**
+ * Headless load testing client, only created when the process runs with -bot
+ * Loops a script of session operations through UMssSubsystem, e.g. for hundreds of clients against one host:
+ *
+ *   UnrealGame -bot -nullrhi -nosound -unattended -MssLan -MssBotScript=find,join,play=30,destroy,wait=2 -MssBotCycles=10
+ *
+ * Find, join and destroy steps start the script over when no answer comes within -MssBotStepTimeout seconds (default 60)
+ * -MssLan keeps discovery on the local network so a host and its bots can share one Linux machine without an online backend
+ * Once connected the bot drives whatever pawn the host possesses it with, AMssBuild5Character in this project
+ ******************************************************************************************/
+UCLASS(ClassGroup = (Subsystem))
+class MULTIPLAYERSESSIONSSUBSYSTEM_API UMssBotSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+private:
+	/** A parsed step of the script */
+	struct FMssBotScriptStep
+	{
+		EMssBotStep Step = EMssBotStep::Wait;
+		float Seconds = 0.f;
+	};
+
+	/** Steps run in order, looped until MaxCycles is reached */
+	TArray<FMssBotScriptStep> Script;
+
+	/** Index of the step being run */
+	int32 StepIndex = 0;
+
+	/** Number of full passes over the script, 0 runs forever */
+	int32 MaxCycles = 0;
+
+	int32 CompletedCycles = 0;
+
+	/** True once the script has started, it waits for the first map to be loaded */
+	bool bScriptStarted = false;
+
+	UPROPERTY()
+	TObjectPtr<UMssSubsystem> MssSubsystem;
+
+	/** Result picked by the last successful Find step */
+	FOnlineSessionSearchResult SessionToJoin;
+
+	FTimerHandle StepTimerHandle;
+	FTimerHandle InputTimerHandle;
+
+	/** Seconds a find, join or destroy step may wait for its answer before the script starts over, from -MssBotStepTimeout */
+	float StepTimeoutInSeconds = 60.f;
+
+	/** Seconds between two synthetic input frames */
+	static constexpr float InputIntervalInSeconds = 1.f / 30.f;
+
+	/** Seconds played so far in the current Play step, drives the input pattern */
+	float PlayedSeconds = 0.f;
+
+	/** Per bot phase of the input pattern so bots do not all move in lockstep */
+	float InputPhase = 0.f;
+
+	/**
+	 * Parses the script from the command line
+	 * Steps are comma separated, Play and Wait take their seconds after '=', e.g. find,join,play=30,destroy,wait=2
+	 */
+	void ParseScript();
+
+	/** Runs the current step */
+	void RunStep();
+
+	/** Moves to the next step, looping or exiting at the end of the script */
+	void AdvanceStep();
+
+	/** Starts over from the first step after a failure */
+	void RestartScript(float InDelayInSeconds);
+
+	/** Starts over when the subsystem never answered the current step */
+	void OnStepTimedOut();
+
+	/** Sends one frame of synthetic move and look input */
+	void SendSyntheticInput();
+
+	/** Starts the script once the first map is loaded */
+	void OnPostLoadMapWithWorld(UWorld* LoadedWorld);
+	FDelegateHandle PostLoadMapWithWorldDelegateHandle;
+
+	void OnFindSessionsComplete(const TArray<FOnlineSessionSearchResult>& SessionResults, bool bWasSuccessful);
+
+	void OnJoinSessionComplete(EOnJoinSessionCompleteResult::Type Result);
+
+	UFUNCTION()
+	void OnDestroySessionComplete(bool bWasSuccessful);
+
+	/** @return the current step, Wait when the script is empty */
+	EMssBotStep GetCurrentStep() const;
+};
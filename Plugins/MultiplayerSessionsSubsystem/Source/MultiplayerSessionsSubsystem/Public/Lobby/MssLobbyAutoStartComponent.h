@@ -0,0 +1,120 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "MssLobbyAutoStartComponent.generated.h"
+
+class AGameModeBase;
+class AController;
+class APlayerController;
+class UMssSubsystem;
+
+/** Seconds left before the match starts, 0 when the countdown has been cancelled */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMssOnLobbyCountdownChanged, int32, SecondsRemaining);
+
+/**
+ * Starts the hosted session and moves everyone to the match once the lobby is full
+ * Added to a game mode, only acts on the host while the session is still pending so the same game mode can run the match
+ *
+ * Full lobby: counts down CountdownInSeconds then starts
+ * Lobby with at least MinPlayersToStart: starts counting down anyway after MinPlayerTimeoutInSeconds
+ ******************************************************************************************/
+UCLASS(ClassGroup = (Session), Config = Game, meta = (BlueprintSpawnableComponent))
+class MULTIPLAYERSESSIONSSUBSYSTEM_API UMssLobbyAutoStartComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Default constructor */
+	UMssLobbyAutoStartComponent();
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Broadcast every second of the countdown and once with 0 when it is cancelled */
+	UPROPERTY(BlueprintAssignable, Category = "Lobby")
+	FMssOnLobbyCountdownChanged OnLobbyCountdownChanged;
+
+	/** @return true while the countdown to the match is running */
+	UFUNCTION(BlueprintPure, Category = "Lobby")
+	bool IsCountingDown() const { return CountdownSecondsRemaining > 0; }
+
+	/** @return true once the countdown has run out and the lobby is on its way to the match */
+	bool IsStartRequested() const { return bStartRequested; }
+
+	/**
+	 * Long package name of the map the session travels to once started, travel options may follow after '?'
+	 * Left empty or missing, the map setting of the hosted session is used when it is an existing map
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Config, Category = "Lobby")
+	FString MatchMapPath;
+
+protected:
+	/** Seconds between the lobby filling up and the travel to the match */
+	UPROPERTY(EditAnywhere, Config, Category = "Lobby", meta = (ClampMin = 0))
+	int32 CountdownInSeconds = 10;
+
+	/** Fewest players a lobby that does not fill up is started with, 0 waits for a full lobby */
+	UPROPERTY(EditAnywhere, Config, Category = "Lobby", meta = (ClampMin = 0))
+	int32 MinPlayersToStart = 2;
+
+	/** Seconds a lobby with at least MinPlayersToStart waits for more players before counting down */
+	UPROPERTY(EditAnywhere, Config, Category = "Lobby", meta = (ClampMin = 0))
+	float MinPlayerTimeoutInSeconds = 120.f;
+
+private:
+	UPROPERTY()
+	TObjectPtr<UMssSubsystem> MssSubsystem;
+
+	/** Players a full lobby holds, read from SETTING_NUMPLAYERSREQUIRED of the hosted session */
+	int32 RequiredPlayers = 0;
+
+	/** Seconds left on the countdown, 0 when not counting down */
+	int32 CountdownSecondsRemaining = 0;
+
+	/** True once the session has been asked to start, nothing is reevaluated after that */
+	bool bStartRequested = false;
+
+	FTimerHandle CountdownTimerHandle;
+	FTimerHandle MinPlayerTimeoutTimerHandle;
+
+	FDelegateHandle PostLoginDelegateHandle;
+	FDelegateHandle LogoutDelegateHandle;
+
+	/** @return the game mode owning this component */
+	AGameModeBase* GetGameMode() const;
+
+	void OnPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer);
+
+	void OnLogout(AGameModeBase* GameMode, AController* Exiting);
+
+	/**
+	 * Starts or stops the countdown and the min player timeout from the current player count
+	 *
+	 * @param InPlayerCountDelta: Correction for a player that is leaving but still counted
+	 */
+	void EvaluateLobby(int32 InPlayerCountDelta = 0);
+
+	void StartCountdown();
+
+	void CancelCountdown();
+
+	void TickCountdown();
+
+	void OnMinPlayerTimeout();
+
+	/** Starts the session, the travel runs once the backend confirmed, nothing is started without a match map */
+	void StartMatch();
+
+	/**
+	 * @param OutMapPath: MatchMapPath, or the map of the hosted session when MatchMapPath does not exist
+	 * @return false if neither is an existing map package
+	 */
+	bool ResolveMatchMapPath(FString& OutMapPath) const;
+
+	UFUNCTION()
+	void OnStartSessionComplete(bool bWasSuccessful);
+};
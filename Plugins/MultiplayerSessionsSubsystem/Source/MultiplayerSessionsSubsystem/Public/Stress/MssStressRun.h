@@ -0,0 +1,159 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Interfaces/OnlineSessionInterface.h"
+#include "MssStressRun.generated.h"
+
+class UMssSubsystem;
+
+/** An operation fired by the stress run */
+UENUM()
+enum class EMssStressOperation : uint8
+{
+	/** Hosts a session, destroying the active one first */
+	Host,
+	/** Hosts twice in the same frame, a double clicked host button */
+	DoubleHost,
+	/** Starts a search, superseding the one in flight */
+	Find,
+	/** Starts several searches in the same frame, a spammed refresh or join by code button */
+	FindBurst,
+	/** Cancels the search in flight */
+	CancelFind,
+	/** Joins the lowest latency session of the last search, searches instead when there is none */
+	Join,
+	/** Destroys the active session */
+	Destroy,
+	/** Starts the active session */
+	Start,
+	/** Shows or hides the session list, starting or stopping its search loop */
+	ToggleSessionList
+};
+
+/**
+ * Rapid fire stress run of UMssSubsystem, driven by the MultiplayerSessionsSubsystem.Stress automation test
+ * Fires a seeded random sequence of session operations at LAN discovery, then waits for the subsystem to settle and checks that:
+ *
+ *   - every operation issued on the backend completed or was cancelled, and no completion arrived twice
+ *   - every host, join and start request was answered by exactly one broadcast
+ *   - no per operation delegate is left bound on the session interface
+ *   - no backend operation took longer than OperationLatencyBudgetInSeconds
+ *
+ * The session recording of the run is kept, a failing seed can be fed back with mss.replay
+ ******************************************************************************************/
+UCLASS(Config = Game)
+class MULTIPLAYERSESSIONSSUBSYSTEM_API UMssStressRun : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Starts the run, switches the subsystem to LAN mode until the run is over
+	 *
+	 * @param InMssSubsystem: Subsystem to stress, its game instance drives the run
+	 * @param InNumOperations: Operations to fire before settling
+	 * @param InSeed: Seed of the operation sequence, the same seed fires the same sequence
+	 * @return false if the run has already started or the subsystem is replaying
+	 */
+	bool Start(UMssSubsystem* InMssSubsystem, int32 InNumOperations, int32 InSeed);
+
+	/** Stops the run before it has settled and restores the subsystem, the run fails */
+	void Abort();
+
+	bool IsRunning() const { return bRunning; }
+
+	/** @return true once the run is over and every check passed */
+	bool HasPassed() const { return bPassed; }
+
+	/** @return why the run failed, empty when it passed */
+	const FString& GetFailureReason() const { return FailureReason; }
+
+	/** @return the path of the session recording of the run, empty when another recording was in progress */
+	const FString& GetRecordingPath() const { return RecordingPath; }
+
+private:
+	/** Upper bound of the random delay between two operations, 0 fires one operation per frame */
+	UPROPERTY(Config)
+	float MaxOperationIntervalInSeconds = 0.1f;
+
+	/** A backend operation taking longer than this fails the run */
+	UPROPERTY(Config)
+	float OperationLatencyBudgetInSeconds = 5.f;
+
+	/** Seconds given to the subsystem to answer everything once the last operation was fired */
+	UPROPERTY(Config)
+	float SettleTimeoutInSeconds = 30.f;
+
+	/** Requests of an operation answered by a broadcast of the subsystem */
+	struct FMssStressCounter
+	{
+		int32 Requested = 0;
+		int32 Completed = 0;
+	};
+
+	TWeakObjectPtr<UMssSubsystem> MssSubsystem;
+
+	bool bRunning = false;
+	bool bPassed = false;
+
+	FString FailureReason;
+	FString RecordingPath;
+
+	FRandomStream RandomStream;
+
+	int32 NumOperationsToFire = 0;
+	int32 NumOperationsFired = 0;
+
+	TMap<EMssStressOperation, int32> FiredOperations;
+
+	FMssStressCounter CreateCounter;
+	FMssStressCounter JoinCounter;
+	FMssStressCounter StartCounter;
+
+	/** True while the run is registered as a consumer of the session list */
+	bool bShowsSessionList = false;
+
+	/** LAN mode before the run, restored once it is over */
+	bool bWasLanMode = false;
+
+	/** True when the run started the recording, it is then stopped and written at the end of the run */
+	bool bOwnsRecording = false;
+
+	/** Recorded operations before this index belong to an earlier run */
+	int32 FirstRecordedOperationIndex = 0;
+
+	int32 NumUnmatchedCompletionsAtStart = 0;
+
+	double SettleStartedAtSeconds = 0.0;
+
+	FTimerHandle OperationTimerHandle;
+	FTimerHandle SettleTimerHandle;
+
+	/** Fires the next operation of the sequence and schedules the one after, or starts settling */
+	void FireNextOperation();
+
+	void FireOperation(EMssStressOperation InOperation);
+
+	/** Checks whether everything has been answered, finishes the run once it has or once SettleTimeoutInSeconds is over */
+	void Settle();
+
+	/** @return true if the subsystem has answered every request of the run */
+	bool HasSettled() const;
+
+	/** Runs the checks, logs the report and restores the subsystem */
+	void Finish(bool bSettled);
+
+	/** Unbinds the run from the subsystem, stops its recording and restores the LAN mode */
+	void RestoreSubsystem();
+
+	UFUNCTION()
+	void OnCreateSessionComplete(bool bWasSuccessful);
+
+	void OnJoinSessionComplete(EOnJoinSessionCompleteResult::Type Result);
+
+	UFUNCTION()
+	void OnStartSessionComplete(bool bWasSuccessful);
+};
@@ -0,0 +1,270 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Subsystem/MssSubsystem.h"
+#include "MssSessionListModel.generated.h"
+
+class UMssSessionListModel;
+
+/** Primary order of the session list, the remaining keys break ties in this same order */
+UENUM(BlueprintType)
+enum class EMssSessionSortKey : uint8
+{
+	Ping,
+	Fill,
+	Map,
+	Mode
+};
+
+/**
+ * What a session row is sorted by
+ * Unique per session thanks to the session id
+ ******************************************************************************************/
+struct MULTIPLAYERSESSIONSSUBSYSTEM_API FMssSessionSortKey
+{
+	/** Round trip rounded down to the sort bucket so small jitter does not move rows */
+	int32 PingBucket = 0;
+
+	/** Fewer open slots sort first, fuller lobbies start sooner */
+	int32 OpenSlots = 0;
+
+	FString MapName;
+	FString GameMode;
+	FString SessionId;
+
+	/** @return true if this key is listed before the other one when sorting by the given primary key */
+	bool IsOrderedBefore(const FMssSessionSortKey& Other, EMssSessionSortKey InPrimaryKey) const;
+
+	bool operator==(const FMssSessionSortKey& Other) const
+	{
+		return PingBucket == Other.PingBucket && OpenSlots == Other.OpenSlots && MapName == Other.MapName
+			&& GameMode == Other.GameMode && SessionId.Equals(Other.SessionId, ESearchCase::CaseSensitive);
+	}
+
+	bool operator!=(const FMssSessionSortKey& Other) const { return !(*this == Other); }
+};
+
+/**
+ * A session of the shared session list, only what the lists display and sort by
+ ******************************************************************************************/
+USTRUCT(BlueprintType)
+struct MULTIPLAYERSESSIONSSUBSYSTEM_API FMssSessionListEntry
+{
+	GENERATED_BODY()
+
+	/** Id of the session, joinable through UMssSubsystem::GetSearchResultById */
+	UPROPERTY(BlueprintReadOnly, Category = "Session List")
+	FString SessionId;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Session List")
+	FString MapName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Session List")
+	FString GameMode;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Session List")
+	FString Players;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Session List")
+	int32 PingInMs = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Session List")
+	int32 OpenSlots = 0;
+
+	/** Hash of everything a row displays, equal fingerprints render the same row, never 0 */
+	uint32 Fingerprint = 0;
+
+	/** @return the fingerprint covering open slots, settings and ping */
+	uint32 ComputeFingerprint() const;
+};
+
+/** Returns the filter a view applies, asked on every refresh */
+DECLARE_DELEGATE_RetVal(FTempCustomSessionSettings, FMssSessionListFilterProvider);
+
+DECLARE_MULTICAST_DELEGATE(FMssOnSessionListViewChanged);
+DECLARE_MULTICAST_DELEGATE(FMssOnSessionListSearchFailed);
+
+/**
+ * Filtered, sorted and paged window on the shared session list
+ * Every list, panel or button showing sessions holds its own view, all views share the searches of the model
+ ******************************************************************************************/
+UCLASS(BlueprintType, ClassGroup = (Session))
+class MULTIPLAYERSESSIONSSUBSYSTEM_API UMssSessionListView : public UObject
+{
+	GENERATED_BODY()
+
+	friend class UMssSessionListModel;
+
+public:
+	/**
+	 * Only sessions matching the filter are listed, "Any" or an empty value matches every value
+	 *
+	 * @param InFilter: Map, game mode and players to match
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Session List")
+	void SetFilter(const FTempCustomSessionSettings& InFilter);
+
+	/**
+	 * @param InSortKey: Primary sort key, the others break ties
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Session List")
+	void SetSortKey(EMssSessionSortKey InSortKey);
+
+	/**
+	 * @param InPingSortBucketInMs: Pings are compared in buckets of this size so jitter does not reorder the list on every refresh
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Session List")
+	void SetPingSortBucketInMs(int32 InPingSortBucketInMs);
+
+	/**
+	 * @param InPageIndex: Page to list, clamped to the last page
+	 * @param InPageSize: Rows per page, 0 lists every matching session on a single page
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Session List")
+	void SetPage(int32 InPageIndex, int32 InPageSize);
+
+	/** @return the rows of the current page in sort order */
+	UFUNCTION(BlueprintPure, Category = "Session List")
+	const TArray<FMssSessionListEntry>& GetRows() const { return Rows; }
+
+	/** @return the number of sessions matching the filter over all pages */
+	UFUNCTION(BlueprintPure, Category = "Session List")
+	int32 GetNumMatchingEntries() const { return NumMatchingEntries; }
+
+	UFUNCTION(BlueprintPure, Category = "Session List")
+	int32 GetNumPages() const;
+
+	/** Recomputes the rows from the model, OnViewChanged is broadcast when they differ from the previous ones */
+	void Refresh();
+
+	/** Optional, when bound the filter is asked for on every refresh instead of being set with SetFilter */
+	FMssSessionListFilterProvider FilterProvider;
+
+	/** Broadcast when the rows of the view have changed */
+	FMssOnSessionListViewChanged OnViewChanged;
+
+private:
+	TWeakObjectPtr<UMssSessionListModel> Model;
+
+	/** Empty values match like "Any" */
+	FTempCustomSessionSettings Filter;
+
+	EMssSessionSortKey SortKey = EMssSessionSortKey::Ping;
+
+	int32 PingSortBucketInMs = 10;
+
+	int32 PageIndex = 0;
+
+	int32 PageSize = 0;
+
+	TArray<FMssSessionListEntry> Rows;
+
+	int32 NumMatchingEntries = 0;
+
+	/** An entry matching the filter with the key it is sorted by */
+	struct FMssSortedEntry
+	{
+		FMssSessionSortKey SortKey;
+		FMssSessionListEntry Entry;
+	};
+
+	/** Every entry matching the filter in sort order, kept across refreshes so only new and changed entries are placed */
+	TArray<FMssSortedEntry> SortedEntries;
+
+	/** True when the filter, sort key or ping bucket changed, the sorted entries are rebuilt on the next refresh */
+	bool bSortedEntriesStale = true;
+
+	/** @return true if the entry is listed with the current filter */
+	bool MatchesFilter(const FMssSessionListEntry& InEntry) const;
+
+	/** @return the sort key of an entry with the current ping bucket */
+	FMssSessionSortKey MakeSortKey(const FMssSessionListEntry& InEntry) const;
+
+	/** Sorts every matching entry of the model from scratch */
+	void RebuildSortedEntries(const TArray<FMssSessionListEntry>& InEntries);
+
+	/**
+	 * Brings the sorted entries in line with the model
+	 * Vanished entries are removed, new entries and entries whose key changed are placed by binary search, the others stay put
+	 */
+	void UpdateSortedEntries(const TArray<FMssSessionListEntry>& InEntries);
+};
+
+/**
+ * Session list shared by every consumer of the subsystem, owned by UMssSubsystem
+ * Runs a single search loop while any consumer is interested, however many lists are shown
+ ******************************************************************************************/
+UCLASS(Config = Game, ClassGroup = (Session))
+class MULTIPLAYERSESSIONSSUBSYSTEM_API UMssSessionListModel : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Starts listening to the searches of the subsystem */
+	void Initialize(UMssSubsystem* InMssSubsystem);
+
+	/** Stops polling and listening, the views are left with their last rows */
+	void Deinitialize();
+
+	/**
+	 * Registers a consumer, the model keeps searching while it has at least one
+	 *
+	 * @param InConsumer: Object interested in fresh sessions, dropped automatically once destroyed
+	 */
+	void AddConsumer(const UObject* InConsumer);
+
+	/** Unregisters a consumer, the search loop stops with the last one */
+	void RemoveConsumer(const UObject* InConsumer);
+
+	/** @return a new view on this model, kept up to date as long as the caller references it */
+	UFUNCTION(BlueprintCallable, Category = "Session List")
+	UMssSessionListView* CreateView();
+
+	/** @return every session of the last search in search order */
+	const TArray<FMssSessionListEntry>& GetEntries() const { return Entries; }
+
+	/** Drops every session, called when the sessions come from another backend from now on */
+	void Reset();
+
+	/** Broadcast when a search of the loop failed, the loop tries again */
+	FMssOnSessionListSearchFailed OnSearchFailed;
+
+private:
+	/** Seconds between the end of a search and the start of the next one while consumers are registered */
+	UPROPERTY(Config)
+	float PollIntervalInSeconds = 1.f;
+
+	UPROPERTY()
+	TObjectPtr<UMssSubsystem> MssSubsystem;
+
+	TArray<TWeakObjectPtr<const UObject>> Consumers;
+
+	TArray<TWeakObjectPtr<UMssSessionListView>> Views;
+
+	TArray<FMssSessionListEntry> Entries;
+
+	/** Generation of the last search started by the loop, only that one is cancelled when the last consumer leaves */
+	uint32 PolledSearchGeneration = 0;
+
+	FTimerHandle PollTimerHandle;
+
+	FDelegateHandle FindSessionsCompleteDelegateHandle;
+
+	/** @return true if a consumer is still alive, dead ones are dropped */
+	bool HasConsumers();
+
+	/** Starts a search unless one is already in flight, its results reach the model either way */
+	void Poll();
+
+	/** Schedules the next search of the loop */
+	void SchedulePoll(float InDelayInSeconds);
+
+	/** Rebuilds the entries from the results of any search of the subsystem */
+	void OnFindSessionsComplete(const TArray<FOnlineSessionSearchResult>& SessionResults, bool bWasSuccessful);
+
+	/** Refreshes every live view, dead ones are dropped */
+	void RefreshViews();
+};
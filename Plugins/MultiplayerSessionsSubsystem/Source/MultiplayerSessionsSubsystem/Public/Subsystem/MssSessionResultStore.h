@@ -0,0 +1,89 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSessionSettings.h"
+
+/**
+ * Compact copy of the last search results, one array per field the plugin reads
+ * Replaces the raw search that holds a full settings map per session, so the raw results can be released once projected
+ * Kept results can be turned back into a search result by session id, carrying every setting the plugin advertises
+ ******************************************************************************************/
+class MULTIPLAYERSESSIONSSUBSYSTEM_API FMssSessionResultStore
+{
+public:
+	/**
+	 * Replaces the stored results with the given ones, in order, until the memory budget is used up
+	 *
+	 * @param InSearchResults: Results to project, the best ones first
+	 * @param InBudgetInBytes: Max memory the store may use, 0 for no limit
+	 * @return the number of results kept, the leading ones of InSearchResults
+	 */
+	int32 Project(const TArray<FOnlineSessionSearchResult>& InSearchResults, int64 InBudgetInBytes);
+
+	/** Drops every stored result and frees the memory */
+	void Reset();
+
+	int32 Num() const { return SessionIds.Num(); }
+
+	/** @return the index of the session with the given id, INDEX_NONE when it is not stored */
+	int32 FindIndex(const FString& InSessionId) const;
+
+	/**
+	 * Rebuilds a search result holding the settings the plugin advertises and what joining and reserving a slot need
+	 * Settings advertised by other code are not kept
+	 *
+	 * @param InIndex: Index of the stored session
+	 * @param OutSearchResult: Filled with the session
+	 * @return false if the index is not valid
+	 */
+	bool MakeSearchResult(int32 InIndex, FOnlineSessionSearchResult& OutSearchResult) const;
+
+	const FString& GetSessionId(int32 InIndex) const { return SessionIds[InIndex]; }
+	int32 GetPingInMs(int32 InIndex) const { return PingsInMs[InIndex]; }
+	int32 GetOpenSlots(int32 InIndex) const { return OpenSlots[InIndex]; }
+
+	/** @return the memory held by the store in bytes, the platform session infos are estimated */
+	int64 GetAllocatedSize() const;
+
+private:
+	TArray<FString> SessionIds;
+	TArray<FString> SessionKeys;
+
+	/** Map, mode and players settings only take a handful of values, names store each of them once */
+	TArray<FName> MapNames;
+	TArray<FName> GameModes;
+	TArray<FName> Players;
+
+	/** Region the host advertises, only a handful of values as well */
+	TArray<FName> Regions;
+
+	/** Last heartbeat timestamp of the host, 0 when it does not advertise one */
+	TArray<int64> Heartbeats;
+
+	TArray<FString> OwningUserNames;
+	
+	TArray<int32> PingsInMs;
+	TArray<int16> OpenSlots;
+	TArray<int16> MaxSlots;
+
+	/** Reservation beacon port of the host, 0 when it does not advertise one */
+	TArray<int32> BeaconPorts;
+	
+	TBitArray<> LanMatches;
+	TBitArray<> UsesPresence;
+	TBitArray<> AllowJoinInProgress;
+
+	/** Platform specific address of the host, shared with the raw result instead of copied */
+	TArray<TSharedPtr<FOnlineSessionInfo>> SessionInfos;
+	TArray<FUniqueNetIdPtr> OwningUserIds;
+
+	TMap<FString, int32> IndexBySessionId;
+
+	/** Estimated size of the platform session info, its concrete type is not known here, not measured */
+	static constexpr int64 EstimatedSessionInfoBytes = 128;
+
+	/** @return an estimate of the memory one more session of the given result would take, names are not counted as they are shared */
+	static int64 EstimateEntrySize(const FOnlineSessionSearchResult& InSearchResult);
+};
@@ -3,13 +3,26 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Interfaces/OnlineSessionInterface.h"
+#include "Beacons/MssBeaconClient.h"
+#include "Subsystem/MssSessionResultStore.h"
+#include "System/MssStats.h"
+#include "System/MssSessionRecording.h"
 #include "MssSubsystem.generated.h"
 
+class AOnlineBeaconHost;
+class AMssBeaconHostObject;
+class UNetDriver;
+class UMssSessionListModel;
+
 #define SETTING_NUMPLAYERSREQUIRED FName("NumPlayers") 
 #define SETTING_FILTERSEED FName("FilterSeed")
 #define SETTING_FILTERSEED_VALUE 94311 
+#define SETTING_HEARTBEAT FName("Heartbeat")
+/** SETTING_REGION of hosts whose region is unknown, only found by the unscoped last step of a search */
+#define SETTING_REGION_GLOBAL TEXT("GLOBAL")
 
 #pragma region Custom Delegates
 
@@ -24,6 +37,8 @@ DECLARE_MULTICAST_DELEGATE_TwoParams(FMultiplayerSessionsOnFindSessionsComplete,
 DECLARE_MULTICAST_DELEGATE_OneParam(FMultiplayerSessionsOnJoinSessionsComplete, EOnJoinSessionCompleteResult::Type Result);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMultiplayerSessionsOnDestroySessionComplete, bool, bWasSuccessful);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMultiplayerSessionsOnStartSessionComplete, bool, bWasSuccessful);
+/** FOnlineSessionSearchResult is not UCLASS so we cannot use DYNAMIC keyword here */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FMultiplayerSessionsOnSessionInviteReceived, const FUniqueNetId& FromId, const FOnlineSessionSearchResult& InviteResult);
 
 #pragma endregion Custom Delegates
 
@@ -31,7 +46,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMultiplayerSessionsOnStartSessionCo
  * Structure to store all the settings to be set while creating a session
  ******************************************************************************************/
 USTRUCT(Blueprintable, BlueprintType)
-struct FTempCustomSessionSettings
+struct MULTIPLAYERSESSIONSSUBSYSTEM_API FTempCustomSessionSettings
 {
 	GENERATED_BODY()
 
@@ -52,7 +67,7 @@ struct FTempCustomSessionSettings
  * Class to handle all the session operations
  * Being a subsystem of game instance this can be called from anywhere
  ******************************************************************************************/
-UCLASS(ClassGroup = (Subsystem))
+UCLASS(Config = Game, ClassGroup = (Subsystem))
 class MULTIPLAYERSESSIONSSUBSYSTEM_API UMssSubsystem : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
@@ -61,6 +76,8 @@ public:
 	/** Default Constructor */
 	UMssSubsystem();
 	
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	
 	virtual void Deinitialize() override;
 
 #pragma region Session Operations
@@ -72,21 +89,45 @@ public:
 	 */
 	void CreateSession(const FTempCustomSessionSettings& InCustomSessionSettings);
 
-	/** Finds sessions for the client to join to */
+	/**
+	 * Finds sessions for the client to join to
+	 * A search already in flight is cancelled first, its results are dropped if they still arrive
+	 * Online searches start in the local region and widen to its neighbours while they find fewer than MinRegionSearchResults sessions
+	 */
 	void FindSessions();
 
+	/**
+	 * Cancels the search in flight on the session interface and the latency probes of its results
+	 * Nothing is broadcast for a cancelled search
+	 */
 	void CancelFindSessions();
+
+	/** @return the generation of the latest search, bumped by every FindSessions and CancelFindSessions */
+	uint32 GetSearchGeneration() const { return SearchGeneration; }
+
+	/** @return true while a search has not completed nor been cancelled */
+	bool IsFindSessionsInProgress() const { return bFindSessionsInProgress; }
 	
 private:
 	bool bFindSessionsInProgress = false;
+
+	/**
+	 * Identifies the latest search, replayed completions carrying an older generation belong to a superseded search and are dropped
+	 */
+	uint32 SearchGeneration = 0;
+
+	/** Handles the result of the current search, shared by the session interface completion and the LAN discovery timeout */
+	void CompleteFindSessions(bool bWasSuccessful);
 	
 public:
 	/**
 	 * Join the session requested by the client
+	 * When the host runs a reservation beacon the slots are reserved first and the join only runs once the host accepted
 	 *
 	 *  @param InSessionToJoin: Passed by the client after selecting the appropriate session he wishes to join
+	 *  @param InPartySize: Number of slots to reserve on the host for the joining party
 	 */
-	void JoinSessions(FOnlineSessionSearchResult& InSessionToJoin);
+	void JoinSessions(FOnlineSessionSearchResult& InSessionToJoin, int32 InPartySize = 1);
 
 	/** Destroys the currently active session */
 	void DestroySession();
@@ -96,6 +137,753 @@ public:
 	
 #pragma endregion Session Operations
 
+#pragma region LAN Mode
+
+	/**
+	 * Switches between the online backend and local broadcast for creating and finding sessions
+	 * Takes effect from the next create or find request
+	 *
+	 * @param bInUseLanMode: True to advertise and discover sessions over the LAN only
+	 */
+	void SetLanMode(bool bInUseLanMode);
+
+	/** @return true when sessions are advertised and discovered over the LAN */
+	bool IsLanMode() const { return bUseLanMode; }
+
+private:
+	/**
+	 * True when sessions are advertised and discovered through local broadcast instead of the online backend
+	 * Read from config, can also be forced with -MssLan on the command line
+	 */
+	UPROPERTY(Config)
+	bool bUseLanMode = false;
+
+	/** Seconds a LAN discovery waits for replies before completing with whatever has been found so far */
+	UPROPERTY(Config)
+	float LanSearchTimeoutInSeconds = 0.5f;
+
+	/** Max number of sessions accepted from a single LAN discovery */
+	UPROPERTY(Config)
+	int32 LanMaxSearchResults = 64;
+
+	/** Fires LanSearchTimeoutInSeconds after a LAN discovery has started */
+	FTimerHandle LanSearchTimeoutTimerHandle;
+
+	/** Called when the LAN discovery window closes before the session interface completed the search */
+	void OnLanSearchTimedOut();
+
+	/**
+	 * LAN discovery does not apply the query settings on the responding hosts
+	 * So drops every reply that was not advertised by this plugin
+	 *
+	 * @param SearchResults: Results of the LAN discovery to filter in place
+	 */
+	static void FilterLanSearchResults(TArray<FOnlineSessionSearchResult>& SearchResults);
+
+public:
+	
+#pragma endregion LAN Mode
+
+#pragma region Join Reservations
+
+	/** @return the host side reservation beacon while a session is hosted, null otherwise */
+	AMssBeaconHostObject* GetBeaconHostObject() const { return BeaconHostObject; }
+
+private:
+	/** True to reserve slots on the host through its beacon before joining, hosts that do not advertise a beacon are joined directly */
+	UPROPERTY(Config)
+	bool bUseJoinReservations = true;
+
+	/** Seconds to wait for the host to answer a reservation request before joining without one */
+	UPROPERTY(Config)
+	float ReservationRequestTimeoutInSeconds = 5.f;
+
+	/** Client side beacon of the reservation request in flight */
+	UPROPERTY()
+	TObjectPtr<AMssBeaconClient> ReservationBeaconClient;
+
+	/** Session the pending reservation was requested for, joined once the host accepts */
+	FOnlineSessionSearchResult PendingReservationSearchResult;
+
+	FTimerHandle ReservationRequestTimeoutTimerHandle;
+
+	/**
+	 * Connects to the beacon of the host and asks it to hold slots for the party
+	 *
+	 * @param InSessionToJoin: Session to reserve slots on
+	 * @param InPartySize: Number of slots to reserve
+	 * @return false if the host does not advertise a beacon or the request could not be sent
+	 */
+	bool RequestJoinReservation(const FOnlineSessionSearchResult& InSessionToJoin, int32 InPartySize);
+
+	/**
+	 * Joins the pending session on acceptance, reports the rejection reason through the join delegate otherwise
+	 *
+	 * @param InBeaconClient: Beacon that answered, answers of any beacon but the current one are ignored
+	 */
+	void OnReservationResponse(EMssReservationResult Result, TWeakObjectPtr<AMssBeaconClient> InBeaconClient);
+
+	/** Called when the host did not answer the reservation request in time */
+	void OnReservationRequestTimedOut();
+
+	/** Tears down the client side beacon of the current request, nothing it answers afterwards reaches the subsystem */
+	void DestroyReservationBeaconClient();
+
+	/**
+	 * Destroys a client beacon on the next tick
+	 * Beacon answers are delivered from inside the beacon net driver tick so they cannot be destroyed right away
+	 */
+	void DestroyBeaconClientNextTick(AMssBeaconClient* InBeaconClient) const;
+
+	/** Runs the session interface join without any reservation */
+	void JoinSessionInternal(FOnlineSessionSearchResult& InSessionToJoin);
+
+	/** Host side beacon listening for reservation requests */
+	UPROPERTY()
+	TObjectPtr<AOnlineBeaconHost> BeaconHost;
+
+	/** Host side reservation bookkeeping registered on BeaconHost */
+	UPROPERTY()
+	TObjectPtr<AMssBeaconHostObject> BeaconHostObject;
+
+	/** Spawns the reservation beacon in the given world, beacons are world actors so this runs again after every travel */
+	void StartBeaconHost(UWorld* InWorld);
+
+	/** Unregisters and destroys the host side beacon */
+	void StopBeaconHost();
+
+	/** Restarts the host side beacon in every map loaded while hosting */
+	void OnPostLoadMapWithWorld(UWorld* LoadedWorld);
+	FDelegateHandle PostLoadMapWithWorldDelegateHandle;
+
+public:
+
+#pragma endregion Join Reservations
+
+#pragma region Admission
+
+	/**
+	 * Decides on the host whether a connecting player may log in, meant to be called from the PreLogin of the game mode
+	 * Checks the live session so a client that cannot play is turned away before it loads the map
+	 *
+	 * @param InPlayerId: Player asking to log in
+	 * @param InNumPlayers: Players already logged in
+	 * @param bInLobbyLocked: True when the lobby is about to move to the match and takes no more players
+	 * @param OutRejectReason: Reason sent back to the client, empty when admitted
+	 * @return true if the player may log in, also when no session is hosted
+	 */
+	bool CanAdmitPlayer(const FUniqueNetIdRepl& InPlayerId, int32 InNumPlayers, bool bInLobbyLocked, FString& OutRejectReason) const;
+
+	/**
+	 * Returns and clears the reason the last host turned this client away with
+	 * The client is sent back to the menu map on rejection so the new menu picks the reason up from here
+	 */
+	FString ConsumeJoinRejectReason();
+
+private:
+	/** Keeps the reason of a failed pending connection for ConsumeJoinRejectReason */
+	void OnNetworkFailure(UWorld* World, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString);
+	FDelegateHandle NetworkFailureDelegateHandle;
+
+	/** Reason the last pending connection has been refused with, empty once consumed */
+	FString LastJoinRejectReason;
+
+public:
+
+#pragma endregion Admission
+
+#pragma region Heartbeat
+
+private:
+	/** Seconds between two heartbeats of a hosted session, 0 disables the heartbeat */
+	UPROPERTY(Config)
+	float HeartbeatIntervalInSeconds = 60.f;
+
+	/**
+	 * Age in seconds after which a found session counts as abandoned and is dropped from the results
+	 * Keep it a few intervals above HeartbeatIntervalInSeconds so a late update or clock drift does not hide live hosts, 0 keeps every session
+	 */
+	UPROPERTY(Config)
+	float StaleHeartbeatThresholdInSeconds = 180.f;
+
+	FTimerHandle HeartbeatTimerHandle;
+
+	/** @return the heartbeat value of now, seconds since the Unix epoch in UTC */
+	static int64 GetHeartbeatTimestamp();
+
+	/** Starts refreshing the heartbeat of the hosted session, the timer lives on the game instance so it survives travel */
+	void StartHeartbeat();
+
+	void StopHeartbeat();
+
+	/** Advertises the current time on the hosted session */
+	void SendHeartbeat();
+
+	/**
+	 * Drops sessions whose host has not refreshed its heartbeat in StaleHeartbeatThresholdInSeconds
+	 * Hosts that do not advertise a heartbeat at all are kept
+	 *
+	 * @param SearchResults: Results of the search to filter in place
+	 */
+	void FilterStaleSearchResults(TArray<FOnlineSessionSearchResult>& SearchResults) const;
+
+public:
+
+#pragma endregion Heartbeat
+
+#pragma region Failed Joins
+
+	/**
+	 * @param InSessionId: Id of the session to look up
+	 * @param OutResult: Filled with the reason the last join of that session failed with
+	 * @return true while a failed join of that session is remembered
+	 */
+	bool GetFailedJoin(const FString& InSessionId, EOnJoinSessionCompleteResult::Type& OutResult) const;
+
+	/** Forgets every failed join, the sessions show up in the next search again */
+	void ClearFailedJoins();
+
+private:
+	/** Seconds a session that was full is hidden, short as slots open up when players leave */
+	UPROPERTY(Config)
+	float FailedJoinSessionFullLifetimeInSeconds = 30.f;
+
+	/** Seconds a session that no longer existed is hidden */
+	UPROPERTY(Config)
+	float FailedJoinSessionGoneLifetimeInSeconds = 300.f;
+
+	/** Seconds a session whose host address could not be resolved is hidden */
+	UPROPERTY(Config)
+	float FailedJoinNoAddressLifetimeInSeconds = 60.f;
+
+	/** A join that failed for a reason that will not change right away */
+	struct FMssFailedJoin
+	{
+		EOnJoinSessionCompleteResult::Type Result = EOnJoinSessionCompleteResult::UnknownError;
+		double ExpiresAtSeconds = 0.0;
+	};
+
+	/** Failed joins by session id, hidden from searches and refused locally until they expire */
+	TMap<FString, FMssFailedJoin> FailedJoins;
+
+	/** Session the join in flight targets, recorded as failed if the join does */
+	FString PendingJoinSessionId;
+
+	/** True from the moment a join is issued until it is answered, a second join is refused meanwhile */
+	bool bJoinInProgress = false;
+
+	/**
+	 * Remembers a failed join when the reason is worth remembering
+	 *
+	 * @param InSessionId: Id of the session the join failed on
+	 * @param InResult: Reason of the failure, only full, gone and unresolved sessions are remembered
+	 */
+	void RecordFailedJoin(const FString& InSessionId, EOnJoinSessionCompleteResult::Type InResult);
+
+	/** Drops the failed joins whose lifetime has run out */
+	void PruneFailedJoins();
+
+	/**
+	 * Drops sessions a join has recently failed on, so they are neither listed nor picked for a quick join
+	 *
+	 * @param SearchResults: Results of the search to filter in place
+	 */
+	void FilterFailedJoinSearchResults(TArray<FOnlineSessionSearchResult>& SearchResults);
+
+public:
+
+#pragma endregion Failed Joins
+
+#pragma region Friends
+
+	/**
+	 * Joins the session a friend is playing in, found through the presence of the friend instead of a session search
+	 * The result is reported through MultiplayerSessionsOnJoinSessionsComplete, the subsystem travels on success
+	 *
+	 * @param InFriendId: Friend whose session to join
+	 */
+	void JoinFriend(const FUniqueNetIdRepl& InFriendId);
+
+	/**
+	 * Joins a session received through presence, an accepted invite or a join request of the platform overlay
+	 * An active session is left first, the subsystem travels on success as no menu may be around to do it
+	 *
+	 * @param InSessionToJoin: Session to join
+	 */
+	void JoinPresenceSession(const FOnlineSessionSearchResult& InSessionToJoin);
+
+	/**
+	 * Travels the first local player to the joined session, used by everything that joins through this subsystem
+	 *
+	 * @return false if the session address could not be resolved
+	 */
+	bool ClientTravelToSession() const;
+
+private:
+	/** True while the join in flight came from presence, the subsystem travels itself when it succeeds */
+	bool bTravelOnJoinComplete = false;
+
+	/**
+	 * Body of JoinSessions, the travel flag is only applied once the join is actually issued
+	 *
+	 * @param InSessionToJoin: Session to join
+	 * @param InPartySize: Number of slots to reserve on the host for the joining party
+	 * @param bInTravelOnComplete: True to travel to the session once joined, for joins no menu is around to finish
+	 */
+	void RequestJoinSession(FOnlineSessionSearchResult& InSessionToJoin, int32 InPartySize, bool bInTravelOnComplete);
+
+	/** True when a presence join waits for the active session to be destroyed */
+	bool bJoinSessionOnDestroy = false;
+
+	/** Session of the presence join waiting for the active session to be destroyed */
+	FOnlineSessionSearchResult SessionToJoinAfterDestruction;
+
+	FOnFindFriendSessionCompleteDelegate FindFriendSessionCompleteDelegate;
+	FDelegateHandle FindFriendSessionCompleteDelegateHandle;
+
+	FOnSessionUserInviteAcceptedDelegate SessionUserInviteAcceptedDelegate;
+	FDelegateHandle SessionUserInviteAcceptedDelegateHandle;
+
+	FOnSessionInviteReceivedDelegate SessionInviteReceivedDelegate;
+	FDelegateHandle SessionInviteReceivedDelegateHandle;
+
+	/** @return the controller id of the first local player, the user the presence lookups run for */
+	int32 GetLocalUserNum() const;
+
+	/** Called when the presence lookup of JoinFriend has completed */
+	void OnFindFriendSessionCompleteCallback(int32 LocalUserNum, bool bWasSuccessful, const TArray<FOnlineSessionSearchResult>& FriendSearchResults);
+
+	/** Called when the player accepted an invite or asked to join a friend from the platform overlay */
+	void OnSessionUserInviteAcceptedCallback(const bool bWasSuccessful, const int32 ControllerId, FUniqueNetIdPtr UserId, const FOnlineSessionSearchResult& InviteResult);
+
+	/** Called when a friend invites the player, passed on to MultiplayerSessionsOnSessionInviteReceived */
+	void OnSessionInviteReceivedCallback(const FUniqueNetId& UserId, const FUniqueNetId& FromId, const FString& AppId, const FOnlineSessionSearchResult& InviteResult);
+
+public:
+
+#pragma endregion Friends
+
+#pragma region Regions
+
+	/** @return the region this instance advertises its sessions in and searches first, empty when unknown */
+	const FString& GetLocalRegion() const { return Region; }
+
+private:
+	/**
+	 * Region key advertised in SETTING_REGION, e.g. EU or NA, hosts of unknown region advertise SETTING_REGION_GLOBAL
+	 * -MssRegion=<key> on the command line takes precedence, a deployment should set one of the two
+	 */
+	UPROPERTY(Config)
+	FString Region;
+
+	/** True to guess Region from the country of the system locale when neither config nor command line set it, a rough last resort */
+	UPROPERTY(Config)
+	bool bGuessRegionFromLocale = true;
+
+	/** Regions searched, in order, when the local one has too few sessions, as a comma separated list per region */
+	UPROPERTY(Config)
+	TMap<FString, FString> RegionNeighbours;
+
+	/** Sessions a search has to find before it stops widening to the neighbouring regions */
+	UPROPERTY(Config)
+	int32 MinRegionSearchResults = 5;
+
+	/** Regions the current search has still to look in, the local one first, an empty entry searches every region */
+	TArray<FString> PendingSearchRegions;
+
+	/** Sessions found in the regions already searched by the current search */
+	TArray<FOnlineSessionSearchResult> RegionSearchResults;
+
+	/** Sets Region from the command line, or from the system locale when allowed and not configured */
+	void DetectLocalRegion();
+
+	/**
+	 * @param OutSearchRegions: Filled with the local region, its neighbours and a last unscoped step, left empty when the local region is unknown
+	 *                          The unscoped step finds hosts of other or unknown regions once the regions nearby have too few sessions
+	 */
+	void GetSearchRegions(TArray<FString>& OutSearchRegions) const;
+
+	/** Runs one session search in the next pending region, or in every region when none is pending */
+	void IssueFindSessions();
+
+public:
+
+#pragma endregion Regions
+
+#pragma region Latency Probes
+
+	/**
+	 * Picks the open session with the lowest round trip from the last search
+	 * Round trips measured by the probes have already replaced the backend ping in the results
+	 *
+	 * @param OutSearchResult: Filled with the chosen session
+	 * @return false when the last search has no joinable session
+	 */
+	bool GetLowestLatencySearchResult(FOnlineSessionSearchResult& OutSearchResult) const;
+
+	/** @return the compact results of the last search, the raw search is released once they are projected */
+	const FMssSessionResultStore& GetSearchResultStore() const { return SearchResultStore; }
+
+	/**
+	 * Rebuilds a stored result of the last search
+	 *
+	 * @param InSessionId: Id of the session to look up
+	 * @param OutSearchResult: Filled with a joinable result of that session
+	 * @return false if the session is not stored, it was left out by the memory budget or a newer search replaced it
+	 */
+	bool GetSearchResultById(const FString& InSessionId, FOnlineSessionSearchResult& OutSearchResult) const;
+
+private:
+	/** Compact results of the last search */
+	FMssSessionResultStore SearchResultStore;
+
+	/** Memory the compact results may take in KB, the lowest latency sessions are kept when a search returns more, 0 for no limit */
+	UPROPERTY(Config)
+	int32 SearchResultStoreBudgetInKB = 512;
+
+	/** True to measure the round trip to the best candidates of every search before reporting the results */
+	UPROPERTY(Config)
+	bool bProbeSessionLatency = true;
+
+	/** Max number of hosts probed concurrently after a search */
+	UPROPERTY(Config)
+	int32 LatencyProbeCandidates = 8;
+
+	/** Seconds the results wait for the probes, hosts that have not answered by then keep the backend ping */
+	UPROPERTY(Config)
+	float LatencyProbeBudgetInSeconds = 1.f;
+
+	/** Seconds a measured round trip is reused before the host is probed again */
+	UPROPERTY(Config)
+	float LatencyProbeCacheLifetimeInSeconds = 30.f;
+
+	/** A probe in flight */
+	struct FMssLatencyProbe
+	{
+		TWeakObjectPtr<AMssBeaconClient> BeaconClient;
+		FString SessionId;
+	};
+	TArray<FMssLatencyProbe> ActiveLatencyProbes;
+
+	/** A round trip measured by a probe */
+	struct FMssMeasuredLatency
+	{
+		int32 RoundTripMs = 0;
+		double MeasuredAtSeconds = 0.0;
+	};
+	
+	/** Measured round trips keyed by session id, reused across searches until they expire */
+	TMap<FString, FMssMeasuredLatency> MeasuredLatencies;
+
+	FTimerHandle LatencyProbeBudgetTimerHandle;
+
+	/** Success flag of the search whose results are waiting for the probes */
+	bool bLastSearchWasSuccessful = false;
+
+	/**
+	 * Starts probing the open sessions of the last search that have no fresh measurement, best backend ping first
+	 *
+	 * @return true when probes have started and the results broadcast is deferred until they finish
+	 */
+	bool StartLatencyProbes();
+
+	/** Called by each probe, records the round trip and finishes once all probes answered */
+	void OnLatencyProbeCompleted(int32 RoundTripMs, FString SessionId);
+
+	/** Called when the probe budget runs out before all probes answered */
+	void OnLatencyProbeBudgetExpired();
+
+	/** Stops the remaining probes and broadcasts the results of the last search */
+	void FinishLatencyProbes();
+
+	/** Stops the remaining probes without broadcasting anything */
+	void CancelLatencyProbes();
+
+	/** Writes the measured round trips into the results and orders them lowest ping first */
+	void ApplyMeasuredLatencies(TArray<FOnlineSessionSearchResult>& SearchResults) const;
+
+	/** Broadcasts the results of the last search to the listeners */
+	void BroadcastSearchResults(bool bWasSuccessful);
+
+	/** Broadcasts an empty search to the listeners, dropping the stored results and the raw search */
+	void BroadcastNoSearchResults(bool bWasSuccessful);
+
+public:
+
+#pragma endregion Latency Probes
+
+#pragma region Session List
+
+	/** @return the session list shared by every menu, panel and button listing sessions */
+	UFUNCTION(BlueprintPure, Category = "Session List")
+	UMssSessionListModel* GetSessionListModel() const { return SessionListModel; }
+
+private:
+	/** Created with the subsystem, runs the single search loop for all its consumers */
+	UPROPERTY()
+	TObjectPtr<UMssSessionListModel> SessionListModel;
+
+public:
+
+#pragma endregion Session List
+
+#pragma region Map Preloading
+
+	/**
+	 * Starts streaming the given map and its dependencies in the background
+	 * Called when a create or join is requested so loading overlaps the backend round trip and the travel finds the map in memory
+	 * The map is kept alive until the next map has been loaded or the request failed
+	 *
+	 * @param InMapPath: Path of the map to preload, travel options after '?' are ignored
+	 */
+	void PreloadMap(const FString& InMapPath);
+
+	/** Lets the preloaded map be garbage collected again */
+	void ReleasePreloadedMap();
+
+private:
+	/**
+	 * Keeps the preloaded world alive until travel picks it up
+	 * Holding the world rather than its package also keeps its levels and the assets they reference out of reach of garbage collection
+	 */
+	UPROPERTY()
+	TObjectPtr<UWorld> PreloadedMapWorld;
+
+	/** Package name of the map being preloaded or already preloaded */
+	FString PreloadedMapPackageName;
+
+	/** Called when the async load of the preloaded map has finished */
+	void OnMapPreloaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+
+public:
+
+#pragma endregion Map Preloading
+
+#pragma region Travel
+
+	/**
+	 * Moves the host to the lobby map as a listen server after the session has been created
+	 * Coming from a standalone menu world this is always a hard travel, the net mode changes
+	 *
+	 * @param InLobbyMapPath: Path of the lobby map without travel options
+	 * @return false if there is no world to travel from
+	 */
+	bool ServerTravelToLobby(const FString& InLobbyMapPath);
+
+	/**
+	 * Moves the host and every connected client to another map, seamlessly when enabled
+	 * With seamless travel clients keep their connection, player controllers and player states are carried over through the transition map
+	 *
+	 * @param InMapPath: Path of the map to travel to
+	 * @return false if this instance is not the authority of a hosted session
+	 */
+	bool ServerTravelToMap(const FString& InMapPath);
+
+	/**
+	 * Reads the settings the hosted session has been created with
+	 * The online session outlives travel so the game mode of every map can pick them up again
+	 *
+	 * @param OutSessionSettings: Filled with the map, game mode and players of the hosted session
+	 * @return false if no session is hosted
+	 */
+	bool GetHostedSessionSettings(FTempCustomSessionSettings& OutSessionSettings) const;
+
+	/** @return true if a session is hosted and has not been started yet, i.e. its players are still in the lobby */
+	bool IsHostedSessionPending() const { return IsSessionInState(EOnlineSessionState::Pending); }
+
+	/**
+	 * Converts the players setting of a session to a player count
+	 *
+	 * @param InPlayers: Value of SETTING_NUMPLAYERSREQUIRED, e.g. "2v2"
+	 * @return the number of players a full session holds, 2 for unknown values
+	 */
+	static int32 GetRequiredPlayerCount(const FString& InPlayers);
+
+private:
+	/** True to move a hosted session between maps with seamless travel instead of reconnecting every client */
+	UPROPERTY(Config)
+	bool bUseSeamlessTravel = true;
+
+	/**
+	 * Small map loaded in between during seamless travel started by ServerTravelToMap
+	 * Left empty the transition map of the project settings is used
+	 */
+	UPROPERTY(Config)
+	FSoftObjectPath SeamlessTransitionMap;
+
+	/** Transition map of the project settings, put back once the travel that overrode it has switched worlds */
+	FSoftObjectPath ProjectTransitionMap;
+
+	/** True while SeamlessTransitionMap overrides the transition map of the project settings */
+	bool bTransitionMapOverridden = false;
+
+	FDelegateHandle SeamlessTravelTransitionDelegateHandle;
+
+	/** Overrides the project transition map with SeamlessTransitionMap for the travel about to start, does nothing when it is empty */
+	void ApplyTransitionMap();
+
+	/** Puts the transition map of the project settings back */
+	void RestoreTransitionMap();
+
+	/** Called on every world switch of a seamless travel */
+	void OnSeamlessTravelTransition(UWorld* InWorld);
+
+public:
+
+#pragma endregion Travel
+
+#pragma region Stats
+
+	/** @return the runtime counters, UMssHUD feeds the widget counters through this */
+	FMssStats& GetStats() { return Stats; }
+	const FMssStats& GetStats() const { return Stats; }
+
+	/** Refreshes the cache sizes owned by the subsystem and returns the counters */
+	const FMssStats& SnapshotStats();
+
+	/**
+	 * Writes the current counters to Saved/Mss/
+	 * Stats.json is overwritten with the latest snapshot, a row is appended to Stats.csv
+	 */
+	void DumpStats();
+
+	/** @return the number of per operation delegates bound on the session interface, 0 once every operation has completed */
+	int32 GetNumBoundOperationDelegates() const;
+
+private:
+	FMssStats Stats;
+
+	/**
+	 * Seconds between two automatic dumps of the counters, 0 disables the periodic dump
+	 * Read from config, can also be set with -MssStatsDump=<seconds> on the command line
+	 */
+	UPROPERTY(Config)
+	float StatsDumpIntervalInSeconds = 0.f;
+
+	FTimerHandle StatsDumpTimerHandle;
+
+	/** Time the join in flight has been requested at, used for the average time to join */
+	double JoinRequestedAtSeconds = 0.0;
+
+public:
+
+#pragma endregion Stats
+
+#pragma region Trace
+
+private:
+	/** Correlation ids of the operations in flight on MssChannel, 0 when none is in flight */
+	uint32 CreateSessionTraceId = 0;
+	uint32 FindSessionsTraceId = 0;
+	uint32 JoinSessionTraceId = 0;
+	uint32 DestroySessionTraceId = 0;
+	uint32 StartSessionTraceId = 0;
+
+public:
+
+#pragma endregion Trace
+
+#pragma region Recording
+
+	/**
+	 * Starts recording every session operation and its outcome, search results included
+	 * Also started by -MssRecord on the command line
+	 *
+	 * @return false while already recording or replaying
+	 */
+	bool StartRecording();
+
+	/**
+	 * Stops recording and writes the recording to Saved/Mss/Recordings/
+	 *
+	 * @param OutPath: Filled with the file written
+	 * @return false if nothing was being recorded or the file could not be written
+	 */
+	bool StopRecording(FString& OutPath);
+
+	bool IsRecording() const { return ActiveRecording.IsValid(); }
+
+	/** @return the recording in progress, null when not recording */
+	const FMssSessionRecording* GetActiveRecording() const { return ActiveRecording.Get(); }
+
+private:
+	TUniquePtr<FMssSessionRecording> ActiveRecording;
+
+	double RecordingStartedAtSeconds = 0.0;
+
+	/** Index in the recording of the operation in flight of each kind */
+	TMap<EMssTraceOperation, int32> RecordedOperationsInFlight;
+
+	/** Records the start of an operation, ignored when not recording */
+	void RecordOperationIssued(EMssTraceOperation InOperation, const FString& InSessionId = FString());
+
+	/**
+	 * Records the outcome of the operation in flight of that kind, ignored when not recording
+	 *
+	 * @param InJoinResult: EOnJoinSessionCompleteResult of joins
+	 * @param InSearchResults: Raw results of searches
+	 */
+	void RecordOperationCompleted(EMssTraceOperation InOperation, bool bWasSuccessful, uint8 InJoinResult = 0, const TArray<FOnlineSessionSearchResult>* InSearchResults = nullptr);
+
+	/** Records that the operation in flight of that kind was cancelled before the backend answered */
+	void RecordOperationCancelled(EMssTraceOperation InOperation);
+
+public:
+
+#pragma endregion Recording
+
+#pragma region Replay
+
+	/**
+	 * Answers searches and joins from a recording instead of the session interface
+	 * Searches are answered in recorded order, joins with the recorded outcome for the same session when there is one
+	 * The recording loops once exhausted so benchmarks can run for as long as needed
+	 * Also started by -MssReplay=<file> with an optional -MssReplayTimeScale=<scale>
+	 *
+	 * @param InPath: Recording written by StopRecording
+	 * @param InTimeScale: Multiplies the recorded backend timings, 0 answers on the next tick
+	 * @return false if the recording could not be loaded or holds no completed search nor join
+	 */
+	bool StartReplay(const FString& InPath, float InTimeScale = 1.f);
+
+	/** Goes back to the session interface, operations in flight are answered by nobody and left to their callers */
+	void StopReplay();
+
+	bool IsReplaying() const { return ReplayRecording.IsValid(); }
+
+private:
+	TUniquePtr<FMssSessionRecording> ReplayRecording;
+
+	float ReplayTimeScale = 1.f;
+
+	/** Index of the next recorded operation to consider for searches and joins */
+	int32 NextReplayedFindIndex = 0;
+	int32 NextReplayedJoinIndex = 0;
+
+	FTimerHandle ReplayFindSessionsTimerHandle;
+	FTimerHandle ReplayJoinSessionTimerHandle;
+
+	/**
+	 * @param InOperation: Kind of operation to look for, cancelled ones are skipped
+	 * @param InOutNextIndex: Where to start looking, moved past the operation found, wraps around
+	 * @param InSessionId: Preferred target of joins, the next join of any target is used when none matches
+	 * @return index of the recorded operation, INDEX_NONE if the recording holds none of that kind
+	 */
+	int32 FindNextReplayedOperation(EMssTraceOperation InOperation, int32& InOutNextIndex, const FString& InSessionId = FString()) const;
+
+	/** Answers the search just issued with the next recorded search after its recorded duration */
+	void ReplayFindSessions(uint32 InSearchGeneration);
+
+	/** Fills the current search with the recorded results and completes it, dropped if the search was superseded */
+	void OnReplayedFindSessionsComplete(uint32 InSearchGeneration, int32 InOperationIndex);
+
+	/** Answers the join just issued with a recorded outcome after its recorded duration */
+	void ReplayJoinSession(const FString& InSessionId);
+
+public:
+
+#pragma endregion Replay
+
 #pragma region Custom Delegates Declaration
 
 	/**
@@ -106,11 +894,45 @@ public:
 	FMultiplayerSessionsOnJoinSessionsComplete MultiplayerSessionsOnJoinSessionsComplete;
 	FMultiplayerSessionsOnDestroySessionComplete MultiplayerSessionsOnDestroySessionComplete;
 	FMultiplayerSessionsOnStartSessionComplete MultiplayerSessionsOnStartSessionComplete;
+	FMultiplayerSessionsOnSessionInviteReceived MultiplayerSessionsOnSessionInviteReceived;
 	
 #pragma endregion Custom Delegates Declaration
 	
+#pragma region Shutdown
+
+	/**
+	 * Withdraws everything this instance advertises, runs only once no matter how often it is called
+	 * Cancels searches, probes and reservations, stops the beacon host and destroys the hosted session
+	 * The destroy is pumped on the calling thread for at most ShutdownDestroyBudgetInSeconds as the process is usually about to exit
+	 *
+	 * @return true if no session was left advertised
+	 */
+	bool ShutdownSessions();
+
 private:
+	/** Bound to FCoreDelegates::OnPreExit, the process may die before any async operation completes after this */
 	void HandleAppExit();
+	FDelegateHandle PreExitDelegateHandle;
+
+	/** Max seconds the shutdown waits for the backend to confirm the hosted session has been destroyed */
+	UPROPERTY(Config)
+	float ShutdownDestroyBudgetInSeconds = 2.f;
+
+	/** True once ShutdownSessions has run, no new session operation is accepted after that */
+	bool bHasShutDown = false;
+
+	/** Result of the shutdown, returned again to later callers */
+	bool bAdvertisementWithdrawn = false;
+
+	/**
+	 * Destroys the hosted session, or joins a destruction already in flight, and ticks only the online subsystem until the backend answers or the budget runs out
+	 *
+	 * @param InTimeBudgetInSeconds: Max seconds to block for
+	 * @return true if the backend confirmed the destruction in time
+	 */
+	bool DestroySessionWithinBudget(float InTimeBudgetInSeconds);
+
+#pragma endregion Shutdown
 
 	/**
 	 * Generates and returns a random unique code to create a session with
@@ -128,7 +950,7 @@ private:
 	 * This variable acts an access point to OnlineSubsystem's session interface
 	 *
 	 * Using this variable only I will be able to call for creation, destruction, joining and finding of sessions
-	 * Initialized in the constructor
+	 * Initialized in Initialize, stays null on the CDO
 	 */
 	IOnlineSessionPtr SessionInterface;
 
@@ -146,6 +968,9 @@ private:
 	
 	FOnFindSessionsCompleteDelegate FindSessionsCompleteDelegate;
 	FDelegateHandle FindSessionsCompleteDelegateHandle;
+
+	FOnCancelFindSessionsCompleteDelegate CancelFindSessionsCompleteDelegate;
+	FDelegateHandle CancelFindSessionsCompleteDelegateHandle;
 	
 	FOnJoinSessionCompleteDelegate JoinSessionCompleteDelegate;
 	FDelegateHandle JoinSessionCompleteDelegateHandle;
@@ -166,6 +991,9 @@ private:
 	/** Called when sessions with given session settings are found */
 	void OnFindSessionsCompleteCallback(bool bWasSuccessful);
 
+	/** Called when the session interface has cancelled a search */
+	void OnCancelFindSessionsCompleteCallback(bool bWasSuccessful);
+
 	/** Called when a session is joined */
 	void OnJoinSessionCompleteCallback(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
 
@@ -185,6 +1013,9 @@ private:
 	 * As we will have to destroy the active session and then create a new one 
 	 */
 	FTempCustomSessionSettings SessionSettingsForTheSessionToCreateAfterDestruction;
+
+	/** Fails the creation waiting on a destruction that did not happen, so every CreateSession call is still answered once */
+	void FailCreateSessionOnDestroy();
 	
 	int32 JoinRetryCounter = 0;
 	
@@ -0,0 +1,102 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineKeyValuePair.h"
+#include "System/MssTrace.h"
+
+class FOnlineSessionSearchResult;
+
+/**
+ * A session as the backend returned it, everything a replay needs to rebuild the search result
+ ******************************************************************************************/
+struct MULTIPLAYERSESSIONSSUBSYSTEM_API FMssRecordedSession
+{
+	/** A single advertised setting of the session */
+	struct FSetting
+	{
+		FName Key;
+		FVariantData Data;
+		uint8 AdvertisementType = 0;
+	};
+
+	FString SessionId;
+	FString OwningUserId;
+	FString OwningUserName;
+	int32 PingInMs = 0;
+	int32 NumPublicConnections = 0;
+	int32 NumOpenPublicConnections = 0;
+	int32 NumOpenPrivateConnections = 0;
+	bool bIsLANMatch = false;
+	TArray<FSetting> Settings;
+
+	/** @return the recorded form of a search result */
+	static FMssRecordedSession FromSearchResult(const FOnlineSessionSearchResult& InSearchResult);
+
+	/**
+	 * Rebuilds a search result, its session info only carries the recorded session id
+	 * Such a result must never reach the session interface, it has no host behind it
+	 */
+	FOnlineSessionSearchResult ToSearchResult() const;
+
+	friend FArchive& operator<<(FArchive& Ar, FMssRecordedSession& Session);
+};
+
+/**
+ * One session operation of UMssSubsystem and its outcome, times are relative to the start of the recording
+ ******************************************************************************************/
+struct MULTIPLAYERSESSIONSSUBSYSTEM_API FMssRecordedOperation
+{
+	EMssTraceOperation Operation = EMssTraceOperation::FindSessions;
+
+	double IssuedAtSeconds = 0.0;
+
+	/** Negative while the operation has neither completed nor been cancelled */
+	double CompletedAtSeconds = -1.0;
+
+	/** True when the operation was cancelled before the backend answered, it has no outcome */
+	bool bWasCancelled = false;
+
+	bool bWasSuccessful = false;
+
+	/** EOnJoinSessionCompleteResult of joins */
+	uint8 JoinResult = 0;
+
+	/** Target of joins */
+	FString SessionId;
+
+	/** Raw results of searches, before any filtering of the subsystem */
+	TArray<FMssRecordedSession> Results;
+
+	/** @return the time the backend took to answer */
+	double GetDurationSeconds() const { return FMath::Max(CompletedAtSeconds - IssuedAtSeconds, 0.0); }
+
+	/** @return true if the operation was never answered, e.g. it was still in flight when the recording stopped */
+	bool IsInFlight() const { return !bWasCancelled && CompletedAtSeconds < 0.0; }
+
+	friend FArchive& operator<<(FArchive& Ar, FMssRecordedOperation& Operation);
+};
+
+/**
+ * Session backend traffic seen by UMssSubsystem, recorded with mss.record or -MssRecord and fed back with mss.replay or -MssReplay=
+ * Stored as a compact binary file under Saved/Mss/Recordings
+ ******************************************************************************************/
+struct MULTIPLAYERSESSIONSSUBSYSTEM_API FMssSessionRecording
+{
+	/** Unix time the recording started at, recorded heartbeats are aged relative to it on replay */
+	int64 RecordedAtUnixTime = 0;
+
+	TArray<FMssRecordedOperation> Operations;
+
+	/** Completions that matched no operation in flight, i.e. duplicated or stray callbacks, kept in memory only */
+	int32 NumUnmatchedCompletions = 0;
+
+	/** @return false if the file could not be written */
+	bool SaveToFile(const FString& InPath) const;
+
+	/** @return false if the file could not be read or is not a recording of a supported version */
+	bool LoadFromFile(const FString& InPath);
+
+	friend FArchive& operator<<(FArchive& Ar, FMssSessionRecording& Recording);
+};
@@ -0,0 +1,66 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Runtime counters of the plugin, kept by UMssSubsystem and fed by UMssHUD
+ * Printed by the mss.stats console command and dumped periodically as JSON and CSV
+ ******************************************************************************************/
+struct MULTIPLAYERSESSIONSSUBSYSTEM_API FMssStats
+{
+	/** Searches sent to the session interface */
+	int64 SearchesIssued = 0;
+
+	/** Session results delivered to the listeners over all searches */
+	int64 SearchResultsReceived = 0;
+
+	/** Session rows created from scratch */
+	int64 WidgetsCreated = 0;
+
+	/** Session rows taken back from the pool instead of being created */
+	int64 WidgetsRecycled = 0;
+
+	/** Join requests received by the subsystem */
+	int64 JoinsAttempted = 0;
+
+	/** Joins the session interface reported as successful */
+	int64 JoinsSucceeded = 0;
+
+	/** Sum of the time from join request to join success, over all successful joins */
+	double TotalTimeToJoinSeconds = 0.0;
+
+	/** Results of the last search held by the compact result store */
+	int32 CachedSearchResults = 0;
+
+	/** Memory held by the compact result store in bytes, the platform session infos are estimated */
+	int64 SearchResultStoreBytes = 0;
+
+	/** Round trips held by the latency probe cache */
+	int32 CachedLatencies = 0;
+
+	/** Session rows currently shown by the HUD */
+	int32 ActiveSessionWidgets = 0;
+
+	/** Sessions held by the shared session list model */
+	int32 IndexedSessionKeys = 0;
+
+	/** Session rows parked in the HUD pool */
+	int32 PooledSessionWidgets = 0;
+
+	/** @return the average time from join request to join success, 0 without any successful join */
+	double GetAverageTimeToJoinSeconds() const;
+
+	/** @return all counters as a single JSON object */
+	FString ToJsonString() const;
+
+	/** @return the column names matching ToCsvRow */
+	static FString GetCsvHeader();
+
+	/** @return all counters as one CSV line prefixed with the UTC time */
+	FString ToCsvRow() const;
+
+	/** @return a multi line human readable summary */
+	FString ToDisplayString() const;
+};
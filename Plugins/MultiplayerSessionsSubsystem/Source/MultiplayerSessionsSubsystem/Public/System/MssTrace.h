@@ -0,0 +1,40 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+
+/**
+ * Trace channel of the session lifecycle, enabled with -trace=cpu,mss
+ * Every session operation logs a begin and an end event sharing a correlation id, also mirrored as Insights bookmarks
+ ******************************************************************************************/
+UE_TRACE_CHANNEL_EXTERN(MssChannel, MULTIPLAYERSESSIONSSUBSYSTEM_API)
+
+/** Session operations traced on MssChannel */
+enum class EMssTraceOperation : uint8
+{
+	CreateSession,
+	FindSessions,
+	JoinSession,
+	DestroySession,
+	StartSession
+};
+
+namespace MssTrace
+{
+	/**
+	 * Logs the start of a session operation
+	 *
+	 * @return the correlation id to hand to EndOperation, never 0
+	 */
+	MULTIPLAYERSESSIONSSUBSYSTEM_API uint32 BeginOperation(EMssTraceOperation InOperation);
+
+	/**
+	 * Logs the completion of a session operation and resets the correlation id, ignored when the id is 0
+	 *
+	 * @param InOutOperationId: Correlation id returned by BeginOperation
+	 * @param bWasSuccessful: Outcome reported by the session interface
+	 */
+	MULTIPLAYERSESSIONSSUBSYSTEM_API void EndOperation(EMssTraceOperation InOperation, uint32& InOutOperationId, bool bWasSuccessful);
+}
@@ -6,9 +6,12 @@
 #include "Blueprint/UserWidget.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "Subsystem/MssSubsystem.h"
+#include "Widgets/MssSessionDataWidget.h"
 #include "MssHUD.generated.h"
 
 class UMssSessionDataWidget;
+class UMssSessionListScrollBox;
+struct FStreamableHandle;
 
 /**
  * HUD class implements the multiplayer sessions subsystem
@@ -80,9 +83,6 @@ private:
 	UFUNCTION(BlueprintCallable, Category = "MssHUD")
 	void HostGame(const FTempCustomSessionSettings& InSessionSettings);
 	
-	/** Called to search a session with the given session settings */
-	void FindGame();
-
 	/**
 	 * Called when user enters any session code he wishes to join
 	 * Function requests the MssSubsystem to find all the active session
@@ -101,7 +101,19 @@ private:
 	 */
 	void JoinSessionViaSessionCode(const TArray<FOnlineSessionSearchResult>& SessionSearchResults);
 
-	void UpdateSessionsList(const TArray<FOnlineSessionSearchResult>& Results);
+	/**
+	 * Brings the listed rows in line with the rows of the session list view
+	 * Only rows that appeared, disappeared or changed are touched, rows are moved in place to follow the sort order
+	 *
+	 * @param InRows: Rows of the current page in sort order
+	 */
+	void UpdateSessionsList(const TArray<FMssSessionListEntry>& InRows);
+
+	/** Called when the rows of the session list view changed */
+	void OnSessionListViewChanged();
+
+	/** Called when a search of the shared session list failed, the list keeps searching */
+	void OnSessionListSearchFailed();
 	
 	/**
 	 * Filters and returns the entered session code so that the code does not exceed the max limit
@@ -121,9 +133,20 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Multiplayer Sessions Subsystem")
 	FString LobbyMapPath = FString("");
 
+	/**
+	 * Switches the subsystem between online and LAN sessions
+	 * Only an actual change of mode clears the current list, as it belongs to the other backend, setting the current mode does nothing
+	 *
+	 * @param bInUseLanMode: True to host and browse sessions on the local network only
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MssHUD")
+	void SetLanMode(bool bInUseLanMode);
+
+	/** Registers the HUD with the shared session list, which keeps searching while anyone is interested */
 	UFUNCTION(BlueprintCallable)
 	void StartFindingSessions();
 	
+	/** Unregisters the HUD from the shared session list, searching stops once no one else is interested */
 	UFUNCTION(BlueprintCallable)
 	void StopFindingSessions();
 	
@@ -135,15 +158,88 @@ private:
 	/** The session code that user wishes to join */
 	FString SessionCodeToJoin = "";
 
-	/** Widget class to add to the session data scroll box */
+	/** Widget class to add to the session data scroll box, streamed in when the session list is first opened */
 	UPROPERTY(EditDefaultsOnly, Category = "Multiplayer Sessions Subsystem")
-	TSubclassOf<UMssSessionDataWidget> SessionDataWidgetClass;
+	TSoftClassPtr<UMssSessionDataWidget> SessionDataWidgetClass;
+
+	/** Keeps the session data widget class loaded while the HUD lives */
+	TSharedPtr<FStreamableHandle> SessionDataWidgetClassHandle;
+
+	/** Starts streaming in the session data widget class unless it is loaded or already loading */
+	void LoadSessionDataWidgetClass();
+
+	/** Lists the rows the view already holds, they were held back while the class was loading */
+	void OnSessionDataWidgetClassLoaded();
 	
 	UPROPERTY()
 	TMap<FString, UMssSessionDataWidget*> ActiveSessionWidgets;
 
-	// Cache last known list so we can diff quickly
-	TSet<FString> LastSessionKeys;
+	/** Session rows removed from the list, reused before creating new ones */
+	UPROPERTY()
+	TArray<TObjectPtr<UMssSessionDataWidget>> SessionDataWidgetPool;
+
+	/** Max number of removed session rows kept for reuse */
+	UPROPERTY(EditDefaultsOnly, Category = "Multiplayer Sessions Subsystem")
+	int32 MaxPooledSessionDataWidgets = 32;
+
+	/** @return a pooled session row, or a new one when the pool is empty */
+	UMssSessionDataWidget* AcquireSessionDataWidget();
+
+	/** Removes the row from the list and parks it in the pool while there is room */
+	void ReleaseSessionDataWidget(UMssSessionDataWidget* InSessionDataWidget);
+
+	/** Releases every row of the list, called when the list is cleared */
+	void ReleaseAllSessionDataWidgets();
+
+	/** Reports the sizes of the widget caches to the subsystem stats */
+	void ReportWidgetStats();
+
+#pragma region Sorted Session List
+
+	/**
+	 * Changes the order of the session list, the rows are moved in place instead of being recreated
+	 *
+	 * @param InSessionSortKey: Primary sort key, the others break ties
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MssHUD")
+	void SetSessionSortKey(EMssSessionSortKey InSessionSortKey);
+
+	/**
+	 * Shows another page of the session list
+	 *
+	 * @param InPageIndex: Page to show, clamped to the last page
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MssHUD")
+	void SetSessionsPage(int32 InPageIndex);
+
+	/** @return the view of the shared session list this HUD shows, for page counts and the like */
+	UFUNCTION(BlueprintPure, Category = "MssHUD")
+	UMssSessionListView* GetSessionListView() const { return SessionListView; }
+
+	/**
+	 * Optional scroll box the rows are kept in in sorted order
+	 * Rows AddSessionDataWidget put anywhere else are moved into it, without it the rows keep the order the blueprint added them in
+	 */
+	UPROPERTY(meta = (BindWidgetOptional))
+	TObjectPtr<UMssSessionListScrollBox> SessionsScrollBox;
+
+	/** Primary order of the session list */
+	UPROPERTY(EditDefaultsOnly, Category = "Multiplayer Sessions Subsystem")
+	EMssSessionSortKey SessionSortKey = EMssSessionSortKey::Ping;
+
+	/** Pings are compared in buckets of this size so jitter does not reorder the list on every refresh */
+	UPROPERTY(EditDefaultsOnly, Category = "Multiplayer Sessions Subsystem", meta = (ClampMin = 1))
+	int32 PingSortBucketInMs = 10;
+
+	/** Rows per page of the session list, 0 lists every matching session */
+	UPROPERTY(EditDefaultsOnly, Category = "Multiplayer Sessions Subsystem", meta = (ClampMin = 0))
+	int32 SessionsPageSize = 0;
+
+	/** Filtered, sorted and paged window on the shared session list of the subsystem */
+	UPROPERTY()
+	TObjectPtr<UMssSessionListView> SessionListView;
+
+#pragma endregion Sorted Session List
 	
 	TObjectPtr<UMssSubsystem> GetMssSubsystem();
 	
@@ -155,6 +251,13 @@ public:
 	 */
 	void JoinTheGivenSession(FOnlineSessionSearchResult& InSessionToJoin);
 
+	/**
+	 * Called from UMssSessionDataWidget::OnJoinSessionButtonClicked, rows only keep the id of their session
+	 *
+	 * @param InSessionId: Id of the session to join, looked up in the results of the last search
+	 */
+	void JoinSessionById(const FString& InSessionId);
+
 	/** Displays a message on the HUD, if it is an error then also sets the message close to be visible
 	 * 
 	 * @param InMessage: Message to display
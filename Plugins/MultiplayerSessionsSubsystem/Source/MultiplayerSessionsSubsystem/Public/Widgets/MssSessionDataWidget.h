@@ -4,10 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
-#include "OnlineSessionSettings.h"
+#include "Subsystem/MssSessionListModel.h"
 #include "MssSessionDataWidget.generated.h"
 
-struct FTempCustomSessionSettings;
 class UTextBlock;
 class UButton;
 class UMssHUD;
@@ -38,6 +37,10 @@ private:
 	UPROPERTY(meta = (BindWidget))
 	TObjectPtr<UTextBlock> GameMode;
 
+	/** Text to show the round trip to the host, optional so older layouts keep working */
+	UPROPERTY(meta = (BindWidgetOptional))
+	TObjectPtr<UTextBlock> Ping;
+
 	/** Button to let user join this session */
 	UPROPERTY(meta = (BindWidget))
 	TObjectPtr<UButton> JoinSessionButton;
@@ -45,19 +48,24 @@ private:
 	/** Ref to the main menu widget set via setter, for when user joins this session we can call the main menu widget to join this session */
 	TWeakObjectPtr<UMssHUD> MssHUDRef;
 	
-	/** Stores the session search result for this widget */
-	FOnlineSessionSearchResult SessionSearchResultRef;
+	/** Id of the session shown, the result itself is looked up in the result store of the subsystem when joining */
+	FString SessionId;
+
+	/** Fingerprint of the session info currently displayed */
+	uint32 DisplayedFingerprint = 0;
 
 	/** Join button clicked callback, calls the main menu widget to join this session */
 	UFUNCTION()
 	void OnJoinSessionButtonClicked();
 	
 public:
-	/** Called from UMssHUD::AddSessionSearchResultsToScrollBox upon adding this widget to the scroll box to fill it with necessary information */
-	void SetSessionInfo(const FOnlineSessionSearchResult& InSessionSearchResultRef, 
-		const FTempCustomSessionSettings& SessionSettings);
+	/** Called from UMssHUD::UpdateSessionsList upon adding or updating this row to fill it with the entry of the session list view */
+	void SetSessionInfo(const FMssSessionListEntry& InEntry);
+
+	/** @return true if the row already displays the session info with the given fingerprint */
+	bool IsDisplaying(uint32 InFingerprint) const { return DisplayedFingerprint == InFingerprint; }
 
-	/** Called from UMssHUD::AddSessionSearchResultsToScrollBox upon adding this widget to the scroll box to set the ref to main menu widget */
+	/** Called from UMssHUD::UpdateSessionsList upon adding this widget to the scroll box to set the ref to main menu widget */
 	void SetMssHUDRef(UMssHUD* InMssHUD);
 	
 };
@@ -0,0 +1,36 @@
+// Copyright (c) 2025 The Unreal Guy. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ScrollBox.h"
+#include "MssSessionListScrollBox.generated.h"
+
+/**
+ * Scroll box listing the session rows of UMssHUD in sorted order
+ * Rows are moved between slots without being recreated, the Slate side is resynced once per batch of moves from the first moved row on
+ ******************************************************************************************/
+UCLASS(ClassGroup = (Widgets))
+class MULTIPLAYERSESSIONSSUBSYSTEM_API UMssSessionListScrollBox : public UScrollBox
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Moves a row to the given index, the Slate widget keeps its old position until SynchronizeSlateOrder
+	 *
+	 * @param InIndex: Index of the row once moved
+	 * @param InRow: Child of this scroll box to move
+	 */
+	void MoveRow(int32 InIndex, UWidget* InRow);
+
+	/**
+	 * Puts the Slate slots in the order of the UMG slots, the row widgets themselves are reused
+	 * Slots before the first moved row are left in place, only the ones from there on are removed and added back
+	 */
+	void SynchronizeSlateOrder();
+
+private:
+	/** Lowest slot index touched by a move since the last SynchronizeSlateOrder, INDEX_NONE when nothing moved */
+	int32 FirstMovedIndex = INDEX_NONE;
+};
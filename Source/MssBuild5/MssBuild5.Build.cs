@@ -9,7 +9,7 @@ public class MssBuild5 : ModuleRules
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore"
-			, "EnhancedInput", "MultiplayerSessionsSubsystem", "OnlineSubsystem", "OnlineSubsystemSteam"
+			, "EnhancedInput", "MultiplayerSessionsSubsystem", "OnlineSubsystem", "OnlineSubsystemSteam", "NetCore", "ReplicationGraph"
 		});
 	}
 }
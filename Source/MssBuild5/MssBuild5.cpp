@@ -1,7 +1,27 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "MssBuild5.h"
-#include "Modules/ModuleManager.h"
+#include "MssBuild5ReplicationGraph.h"
+#include "Engine/NetDriver.h"
+#include "UObject/Package.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, MssBuild5, "MssBuild5" );
- 
\ No newline at end of file
+void FMssBuild5Module::StartupModule()
+{
+	// Only the game net driver gets the graph, beacon drivers keep the default relevancy
+	UReplicationDriver::CreateReplicationDriverDelegate().BindLambda([](UNetDriver* ForNetDriver, const FURL& URL, UWorld* World) -> UReplicationDriver*
+	{
+		if (!ForNetDriver || ForNetDriver->NetDriverName != NAME_GameNetDriver || !UMssBuild5ReplicationGraph::IsEnabled())
+		{
+			return nullptr;
+		}
+
+		return NewObject<UMssBuild5ReplicationGraph>(GetTransientPackage());
+	});
+}
+
+void FMssBuild5Module::ShutdownModule()
+{
+	UReplicationDriver::CreateReplicationDriverDelegate().Unbind();
+}
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FMssBuild5Module, MssBuild5, "MssBuild5" );
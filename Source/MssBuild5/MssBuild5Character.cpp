@@ -10,9 +10,19 @@
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "MssBuild5ReplicationGraph.h"
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 
+static TAutoConsoleVariable<bool> CVarMssAdaptiveNetUpdateFrequency(
+	TEXT("mss.Character.AdaptiveNetUpdateFrequency"),
+	true,
+	TEXT("Adapts the net update frequency of characters to movement and distance to players, 0 keeps the class default for a baseline"),
+	ECVF_Default);
+
 //////////////////////////////////////////////////////////////////////////
 // AMssBuild5Character
 
@@ -54,6 +64,68 @@ AMssBuild5Character::AMssBuild5Character()
 	// are set in the derived blueprint asset named ThirdPersonCharacter (to avoid direct content references in C++)
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Replication
+
+void AMssBuild5Character::UpdateAdaptiveNetUpdateFrequency(bool bIsNearPlayer)
+{
+	const AMssBuild5Character* DefaultCharacter = GetDefault<AMssBuild5Character>(GetClass());
+	float Frequency = DefaultCharacter->GetNetUpdateFrequency();
+	float MinFrequency = DefaultCharacter->GetMinNetUpdateFrequency();
+
+	if (CVarMssAdaptiveNetUpdateFrequency.GetValueOnGameThread())
+	{
+		// The engine backs off an actor that sends nothing down to its min frequency, let it reach the idle one
+		MinFrequency = FMath::Min(IdleNetUpdateFrequency, MinFrequency);
+
+		const bool bIsIdle = !GetCharacterMovement()->IsFalling() && GetVelocity().SizeSquared() < FMath::Square(IdleSpeedThreshold);
+		
+		if (bIsIdle)
+		{
+			Frequency = IdleNetUpdateFrequency;
+		}
+		else if (!bIsNearPlayer)
+		{
+			Frequency = DistantNetUpdateFrequency;
+		}
+		else
+		{
+			Frequency = ActiveNetUpdateFrequency;
+		}
+	}
+
+	if (!FMath::IsNearlyEqual(MinFrequency, GetMinNetUpdateFrequency()))
+	{
+		SetMinNetUpdateFrequency(MinFrequency);
+	}
+
+	if (FMath::IsNearlyEqual(Frequency, GetNetUpdateFrequency()))
+	{
+		return;
+	}
+
+	// Starting to move after idling should not wait for the next slow update
+	const bool bSpeedingUp = Frequency > GetNetUpdateFrequency();
+	
+	SetNetUpdateFrequency(Frequency);
+
+	// The replication graph works from its own per actor period rather than the actor frequency
+	if (const UNetDriver* NetDriver = GetNetDriver())
+	{
+		if (UMssBuild5ReplicationGraph* ReplicationGraph = NetDriver->GetReplicationDriver<UMssBuild5ReplicationGraph>())
+		{
+			ReplicationGraph->SetActorReplicationFrequency(this, Frequency);
+		}
+	}
+
+	if (bSpeedingUp)
+	{
+		ForceNetUpdate();
+	}
+
+	UE_LOG(LogTemplateCharacter, Verbose, TEXT("'%s' net update frequency %.0f"), *GetNameSafe(this), Frequency);
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Input
 
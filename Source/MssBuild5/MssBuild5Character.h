@@ -46,6 +46,12 @@ class AMssBuild5Character : public ACharacter
 
 public:
 	AMssBuild5Character();
+
+	/**
+	 * Picks the update frequency from movement activity and distance to the other players, server only
+	 * Called by the game mode for every character in one pass, it knows where all players are
+	 */
+	void UpdateAdaptiveNetUpdateFrequency(bool bIsNearPlayer);
 	
 
 protected:
@@ -63,6 +69,24 @@ protected:
 
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
+protected:
+
+	/** Update frequency while moving close to a player */
+	UPROPERTY(EditDefaultsOnly, Category = Replication)
+	float ActiveNetUpdateFrequency = 60.f;
+
+	/** Update frequency while moving far from every other player */
+	UPROPERTY(EditDefaultsOnly, Category = Replication)
+	float DistantNetUpdateFrequency = 15.f;
+
+	/** Update frequency while standing still on the ground */
+	UPROPERTY(EditDefaultsOnly, Category = Replication)
+	float IdleNetUpdateFrequency = 4.f;
+
+	/** Characters slower than this on the ground are idle */
+	UPROPERTY(EditDefaultsOnly, Category = Replication)
+	float IdleSpeedThreshold = 10.f;
+
 public:
 	/** Returns CameraBoom subobject **/
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
@@ -2,8 +2,17 @@
 
 #include "MssBuild5GameMode.h"
 #include "MssBuild5Character.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "Lobby/MssLobbyAutoStartComponent.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "TimerManager.h"
 #include "UObject/ConstructorHelpers.h"
 
+DEFINE_LOG_CATEGORY_STATIC(LogMssBuild5GameMode, Log, All);
+
 AMssBuild5GameMode::AMssBuild5GameMode()
 {
 	// set default pawn class to our Blueprinted character
@@ -12,4 +21,142 @@ AMssBuild5GameMode::AMssBuild5GameMode()
 	{
 		DefaultPawnClass = PlayerPawnBPClass.Class;
 	}
+
+	// lobby to match travel keeps every client connected
+	bUseSeamlessTravel = true;
+
+	LobbyAutoStartComponent = CreateDefaultSubobject<UMssLobbyAutoStartComponent>(TEXT("LobbyAutoStartComponent"));
+}
+
+void AMssBuild5GameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	// the online session survives both hard and seamless travel, pick its settings up again in every map
+	if (const UGameInstance* GameInstance = GetGameInstance())
+	{
+		if (const UMssSubsystem* MssSubsystem = GameInstance->GetSubsystem<UMssSubsystem>())
+		{
+			bIsHostingSession = MssSubsystem->GetHostedSessionSettings(HostedSessionSettings);
+		}
+	}
+
+	NumSeamlessTravelPlayers = 0;
+}
+
+void AMssBuild5GameMode::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// the game mode only exists on the server, one timer covers every character
+	GetWorldTimerManager().SetTimer(AdaptiveNetUpdateTimerHandle, this, &AMssBuild5GameMode::UpdateCharacterNetUpdateFrequencies,
+		NetUpdateFrequencyEvaluationInterval, true);
+}
+
+void AMssBuild5GameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(AdaptiveNetUpdateTimerHandle);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AMssBuild5GameMode::UpdateCharacterNetUpdateFrequencies()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(AMssBuild5GameMode::UpdateCharacterNetUpdateFrequencies);
+
+	if (GetNetMode() == NM_Standalone)
+		return;
+
+	// a player within the relevance distance of a character lies in one of the 9 cells around the character's
+	const double CellSize = FMath::Max(DistantRelevanceDistance, 1.f);
+	const auto GetCell = [CellSize](const FVector& Location)
+	{
+		return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+	};
+
+	TMap<FIntPoint, TArray<const APawn*, TInlineAllocator<4>>> PlayerPawnsByCell;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (const APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr)
+		{
+			PlayerPawnsByCell.FindOrAdd(GetCell(PlayerPawn->GetActorLocation())).Add(PlayerPawn);
+		}
+	}
+
+	const double RelevanceDistanceSquared = FMath::Square(DistantRelevanceDistance);
+	for (TActorIterator<AMssBuild5Character> It(GetWorld()); It; ++It)
+	{
+		AMssBuild5Character* Character = *It;
+		const FVector Location = Character->GetActorLocation();
+		const FIntPoint Cell = GetCell(Location);
+
+		bool bIsNearPlayer = false;
+		for (int32 OffsetY = -1; OffsetY <= 1 && !bIsNearPlayer; ++OffsetY)
+		{
+			for (int32 OffsetX = -1; OffsetX <= 1 && !bIsNearPlayer; ++OffsetX)
+			{
+				const auto* PlayerPawns = PlayerPawnsByCell.Find(Cell + FIntPoint(OffsetX, OffsetY));
+				if (!PlayerPawns)
+					continue;
+
+				for (const APawn* PlayerPawn : *PlayerPawns)
+				{
+					if (PlayerPawn != Character && FVector::DistSquared(PlayerPawn->GetActorLocation(), Location) <= RelevanceDistanceSquared)
+					{
+						bIsNearPlayer = true;
+						break;
+					}
+				}
+			}
+		}
+
+		Character->UpdateAdaptiveNetUpdateFrequency(bIsNearPlayer);
+	}
+}
+
+void AMssBuild5GameMode::PreLogin(const FString& Options, const FString& Address, const FUniqueNetIdRepl& UniqueId, FString& ErrorMessage)
+{
+	Super::PreLogin(Options, Address, UniqueId, ErrorMessage);
+
+	if (!ErrorMessage.IsEmpty() || !bIsHostingSession)
+		return;
+
+	if (const UGameInstance* GameInstance = GetGameInstance())
+	{
+		if (const UMssSubsystem* MssSubsystem = GameInstance->GetSubsystem<UMssSubsystem>())
+		{
+			const bool bLobbyLocked = LobbyAutoStartComponent && LobbyAutoStartComponent->IsStartRequested();
+			if (!MssSubsystem->CanAdmitPlayer(UniqueId, GetNumPlayers(), bLobbyLocked, ErrorMessage))
+			{
+				UE_LOG(LogMssBuild5GameMode, Log, TEXT("PreLogin refused %s: %s"), *Address, *ErrorMessage);
+			}
+		}
+	}
+}
+
+void AMssBuild5GameMode::HandleSeamlessTravelPlayer(AController*& C)
+{
+	Super::HandleSeamlessTravelPlayer(C);
+
+	++NumSeamlessTravelPlayers;
+}
+
+void AMssBuild5GameMode::PostSeamlessTravel()
+{
+	Super::PostSeamlessTravel();
+
+	UE_LOG(LogMssBuild5GameMode, Log, TEXT("Seamless travel complete, %d player(s) carried over, hosting: %s"),
+		NumSeamlessTravelPlayers, bIsHostingSession ? TEXT("true") : TEXT("false"));
+}
+
+void AMssBuild5GameMode::TravelToMatch(const FString& MatchMapPath)
+{
+	if (UGameInstance* GameInstance = GetGameInstance())
+	{
+		if (UMssSubsystem* MssSubsystem = GameInstance->GetSubsystem<UMssSubsystem>())
+		{
+			MssSubsystem->ServerTravelToMap(MatchMapPath);
+		}
+	}
 }
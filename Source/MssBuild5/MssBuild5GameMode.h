@@ -4,8 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "Subsystem/MssSubsystem.h"
 #include "MssBuild5GameMode.generated.h"
 
+class UMssLobbyAutoStartComponent;
+
 UCLASS(minimalapi)
 class AMssBuild5GameMode : public AGameModeBase
 {
@@ -13,6 +16,59 @@ class AMssBuild5GameMode : public AGameModeBase
 
 public:
 	AMssBuild5GameMode();
+
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Turns away players the hosted session has no room for or that arrive while the lobby is moving to the match */
+	virtual void PreLogin(const FString& Options, const FString& Address, const FUniqueNetIdRepl& UniqueId, FString& ErrorMessage) override;
+
+	virtual void PostSeamlessTravel() override;
+
+	virtual void HandleSeamlessTravelPlayer(AController*& C) override;
+
+	/** Moves the whole session to the given map, seamlessly so clients keep their connection */
+	UFUNCTION(BlueprintCallable, Category = Session)
+	void TravelToMatch(const FString& MatchMapPath);
+
+	/** Returns the settings of the hosted session, valid on the host once InitGame has run **/
+	const FTempCustomSessionSettings& GetHostedSessionSettings() const { return HostedSessionSettings; }
+
+protected:
+	/** Settings of the hosted session, read again after every travel as the online session outlives the map */
+	UPROPERTY(BlueprintReadOnly, Category = Session)
+	FTempCustomSessionSettings HostedSessionSettings;
+
+	/** True when this map is run by the host of an online session */
+	UPROPERTY(BlueprintReadOnly, Category = Session)
+	bool bIsHostingSession = false;
+
+	/** Starts the session and travels to the match once the lobby is full */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Session)
+	TObjectPtr<UMssLobbyAutoStartComponent> LobbyAutoStartComponent;
+
+	/** Seconds between two passes over the characters picking their net update frequency */
+	UPROPERTY(EditDefaultsOnly, Category = Replication)
+	float NetUpdateFrequencyEvaluationInterval = 0.25f;
+
+	/** Characters further than this from every other player use their distant net update frequency */
+	UPROPERTY(EditDefaultsOnly, Category = Replication)
+	float DistantRelevanceDistance = 5000.f;
+
+private:
+	/**
+	 * Updates the net update frequency of every character, server only
+	 * Player pawns are bucketed once in a grid of the relevance distance so each character only looks at the cells around it
+	 */
+	void UpdateCharacterNetUpdateFrequencies();
+
+	/** Players brought over by the last seamless travel */
+	int32 NumSeamlessTravelPlayers = 0;
+
+	FTimerHandle AdaptiveNetUpdateTimerHandle;
 };
 
 
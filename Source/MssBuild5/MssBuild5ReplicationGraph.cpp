@@ -0,0 +1,269 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MssBuild5ReplicationGraph.h"
+#include "ReplicationGraphTypes.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/Engine.h"
+#include "Engine/NetConnection.h"
+#include "Misc/CommandLine.h"
+#include "UObject/UObjectIterator.h"
+
+DEFINE_LOG_CATEGORY(LogMssBuild5ReplicationGraph);
+
+bool UMssBuild5ReplicationGraph::IsEnabled()
+{
+	if (FParse::Param(FCommandLine::Get(), TEXT("NoMssRepGraph")))
+	{
+		return false;
+	}
+
+	return FParse::Param(FCommandLine::Get(), TEXT("MssRepGraph")) || GetDefault<UMssBuild5ReplicationGraph>()->bEnableReplicationGraph;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Class settings
+
+void UMssBuild5ReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// Blueprint classes loaded later inherit the settings of their closest native parent
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		const AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject(false));
+		if (!ActorCDO || !ActorCDO->GetIsReplicated())
+		{
+			continue;
+		}
+
+		// Leftovers of blueprint recompilation
+		if (Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		FClassReplicationInfo ClassInfo;
+		ClassInfo.SetCullDistanceSquared(ActorCDO->GetNetCullDistanceSquared());
+		ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(ActorCDO->GetNetUpdateFrequency());
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+
+		GetMappingPolicy(Class);
+	}
+
+	DestructInfoMaxDistanceSquared = FMath::Square(DestructionInfoMaxDistance);
+}
+
+EMssBuild5ClassRepNodeMapping UMssBuild5ReplicationGraph::GetMappingPolicy(const UClass* Class)
+{
+	if (const EMssBuild5ClassRepNodeMapping* Policy = ClassRepNodePolicies.Find(Class))
+	{
+		return *Policy;
+	}
+
+	EMssBuild5ClassRepNodeMapping Policy = EMssBuild5ClassRepNodeMapping::NotRouted;
+	const AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+
+	// The per connection node of the base graph gathers each connection's own player controller and view target
+	if (Class->IsChildOf(APlayerController::StaticClass()))
+	{
+		Policy = EMssBuild5ClassRepNodeMapping::NotRouted;
+	}
+	else if (ActorCDO && ActorCDO->GetIsReplicated())
+	{
+		if (ActorCDO->bOnlyRelevantToOwner)
+		{
+			Policy = EMssBuild5ClassRepNodeMapping::RelevantOwnerConnection;
+		}
+		else if (ActorCDO->bAlwaysRelevant)
+		{
+			Policy = EMssBuild5ClassRepNodeMapping::RelevantAllConnections;
+		}
+		else if (ActorCDO->IsReplicatingMovement())
+		{
+			Policy = EMssBuild5ClassRepNodeMapping::Spatialize_Dynamic;
+		}
+		else if (ActorCDO->NetDormancy > DORM_Awake)
+		{
+			Policy = EMssBuild5ClassRepNodeMapping::Spatialize_Dormancy;
+		}
+		else
+		{
+			Policy = EMssBuild5ClassRepNodeMapping::Spatialize_Static;
+		}
+	}
+
+	ClassRepNodePolicies.Add(Class, Policy);
+	
+	return Policy;
+}
+
+void UMssBuild5ReplicationGraph::SetActorReplicationFrequency(AActor* Actor, float NetUpdateFrequency)
+{
+	if (FGlobalActorReplicationInfo* GlobalInfo = GlobalActorReplicationInfoMap.Find(Actor))
+	{
+		GlobalInfo->Settings.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(NetUpdateFrequency);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Nodes
+
+void UMssBuild5ReplicationGraph::InitGlobalGraphNodes()
+{
+	Super::InitGlobalGraphNodes();
+
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = SpatialGridCellSize;
+	GridNode->SpatialBias = SpatialGridBias;
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+
+	UE_LOG(LogMssBuild5ReplicationGraph, Log, TEXT("Replication graph initialized, grid cell size %.0f"), SpatialGridCellSize);
+}
+
+void UMssBuild5ReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	// Gathers the player controller and view target of the connection, and the owner only actors of the connection
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantForConnectionNode = CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(AlwaysRelevantForConnectionNode, RepGraphConnection);
+
+	AlwaysRelevantForConnectionNodes.Add(RepGraphConnection->NetConnection, AlwaysRelevantForConnectionNode);
+}
+
+void UMssBuild5ReplicationGraph::RemoveClientConnection(UNetConnection* NetConnection)
+{
+	AlwaysRelevantForConnectionNodes.Remove(NetConnection);
+
+	Super::RemoveClientConnection(NetConnection);
+}
+
+int32 UMssBuild5ReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	UpdateOwnerOnlyActorRoutes();
+
+	return Super::ServerReplicateActors(DeltaSeconds);
+}
+
+void UMssBuild5ReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case EMssBuild5ClassRepNodeMapping::NotRouted:
+		break;
+
+	case EMssBuild5ClassRepNodeMapping::RelevantOwnerConnection:
+		AddOwnerOnlyActor(ActorInfo);
+		break;
+
+	case EMssBuild5ClassRepNodeMapping::RelevantAllConnections:
+		// Actors of streamed levels are only gathered for connections that have the level loaded
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+
+	case EMssBuild5ClassRepNodeMapping::Spatialize_Static:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+
+	case EMssBuild5ClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+
+	case EMssBuild5ClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+	}
+}
+
+void UMssBuild5ReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case EMssBuild5ClassRepNodeMapping::NotRouted:
+		break;
+
+	case EMssBuild5ClassRepNodeMapping::RelevantOwnerConnection:
+		RemoveOwnerOnlyActor(ActorInfo);
+		break;
+
+	case EMssBuild5ClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+
+	case EMssBuild5ClassRepNodeMapping::Spatialize_Static:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+
+	case EMssBuild5ClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+
+	case EMssBuild5ClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+	}
+}
+
+UReplicationGraphNode_AlwaysRelevant_ForConnection* UMssBuild5ReplicationGraph::FindOwnerNode(const AActor* Actor) const
+{
+	UNetConnection* OwningConnection = Actor ? Actor->GetNetConnection() : nullptr;
+	const TObjectPtr<UReplicationGraphNode_AlwaysRelevant_ForConnection>* Node = OwningConnection ? AlwaysRelevantForConnectionNodes.Find(OwningConnection) : nullptr;
+
+	return Node ? Node->Get() : nullptr;
+}
+
+void UMssBuild5ReplicationGraph::AddOwnerOnlyActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	FMssOwnerOnlyActorRoute& Route = OwnerOnlyActorRoutes.Add(ActorInfo.Actor, { ActorInfo, nullptr });
+
+	// The owner is usually set on spawn, e.g. weapons and inventory handed to a pawn, otherwise the actor waits for it
+	if (UReplicationGraphNode_AlwaysRelevant_ForConnection* Node = FindOwnerNode(ActorInfo.Actor))
+	{
+		Node->NotifyAddNetworkActor(ActorInfo);
+		Route.Node = Node;
+	}
+}
+
+void UMssBuild5ReplicationGraph::RemoveOwnerOnlyActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	const FMssOwnerOnlyActorRoute* Route = OwnerOnlyActorRoutes.Find(ActorInfo.Actor);
+	if (!Route)
+		return;
+
+	// Null while it had no owner, stale once the node is gone with its connection
+	if (Route->Node.IsValid())
+	{
+		Route->Node->NotifyRemoveNetworkActor(ActorInfo);
+	}
+
+	OwnerOnlyActorRoutes.Remove(ActorInfo.Actor);
+}
+
+void UMssBuild5ReplicationGraph::UpdateOwnerOnlyActorRoutes()
+{
+	for (TPair<TObjectKey<AActor>, FMssOwnerOnlyActorRoute>& OwnerOnlyActorRoute : OwnerOnlyActorRoutes)
+	{
+		FMssOwnerOnlyActorRoute& Route = OwnerOnlyActorRoute.Value;
+
+		UReplicationGraphNode_AlwaysRelevant_ForConnection* Node = FindOwnerNode(Route.ActorInfo.Actor);
+		if (Node == Route.Node.Get())
+			continue;
+
+		if (Route.Node.IsValid())
+		{
+			Route.Node->NotifyRemoveNetworkActor(Route.ActorInfo);
+		}
+
+		if (Node)
+		{
+			Node->NotifyAddNetworkActor(Route.ActorInfo);
+		}
+
+		Route.Node = Node;
+	}
+}
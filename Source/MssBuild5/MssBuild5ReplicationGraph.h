@@ -0,0 +1,113 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "MssBuild5ReplicationGraph.generated.h"
+
+class UReplicationGraphNode_ActorList;
+class UReplicationGraphNode_AlwaysRelevant_ForConnection;
+class UReplicationGraphNode_GridSpatialization2D;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogMssBuild5ReplicationGraph, Log, All);
+
+/** How replicated actors of a class are routed into the graph */
+enum class EMssBuild5ClassRepNodeMapping : uint8
+{
+	/** Not routed into any node, the class does not replicate or is gathered by the per connection node itself like player controllers */
+	NotRouted,
+	/** Only relevant to its owner, routed to the per connection node of the owning connection */
+	RelevantOwnerConnection,
+	/** Replicated to every connection, e.g. game state and player states */
+	RelevantAllConnections,
+	/** Spatialized once, never moves */
+	Spatialize_Static,
+	/** Spatialized every frame, e.g. characters */
+	Spatialize_Dynamic,
+	/** Spatialized while awake, treated as static once dormant */
+	Spatialize_Dormancy
+};
+
+/**
+ * Optional replication graph of the project, enabled with bEnableReplicationGraph or -MssRepGraph
+ * Characters go to a 2D spatial grid, always relevant actors to a shared list, owner only actors to the per connection node of their owner
+ * The cost per connection then depends on the actors near it instead of every replicated actor of the map
+ */
+UCLASS(transient, config=Engine)
+class UMssBuild5ReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns true when the game net driver should use this graph instead of per actor relevancy **/
+	static bool IsEnabled();
+
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual void RemoveClientConnection(UNetConnection* NetConnection) override;
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+	/** Changes how often the graph considers an actor, used by actors that adapt their own net update frequency **/
+	void SetActorReplicationFrequency(AActor* Actor, float NetUpdateFrequency);
+
+protected:
+	/** True to replace the default relevancy of the game net driver with this graph */
+	UPROPERTY(config)
+	bool bEnableReplicationGraph = false;
+
+	/** Size of a cell of the spatial grid in world units */
+	UPROPERTY(config)
+	float SpatialGridCellSize = 10000.f;
+
+	/** Offset applied to world locations so the playable area starts in positive grid space */
+	UPROPERTY(config)
+	FVector2D SpatialGridBias = FVector2D(-150000.f, -200000.f);
+
+	/** Destroyed actors further away than this are not told to the connection */
+	UPROPERTY(config)
+	float DestructionInfoMaxDistance = 30000.f;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_GridSpatialization2D> GridNode;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
+
+	/** Per connection node of each client connection, owner only actors are added to the one of their owner */
+	UPROPERTY()
+	TMap<TObjectPtr<UNetConnection>, TObjectPtr<UReplicationGraphNode_AlwaysRelevant_ForConnection>> AlwaysRelevantForConnectionNodes;
+
+private:
+	/** Returns how actors of the class are routed, computed from the class default object on first use so blueprint classes loaded later are covered **/
+	EMssBuild5ClassRepNodeMapping GetMappingPolicy(const UClass* Class);
+
+	/** Routing computed per class */
+	TMap<TObjectKey<UClass>, EMssBuild5ClassRepNodeMapping> ClassRepNodePolicies;
+
+	/** Where an owner only actor is routed */
+	struct FMssOwnerOnlyActorRoute
+	{
+		FNewReplicatedActorInfo ActorInfo;
+
+		/** Per connection node of the owner the actor was added to, null while the actor has no owning connection */
+		TWeakObjectPtr<UReplicationGraphNode_AlwaysRelevant_ForConnection> Node;
+	};
+
+	/** Every owner only actor of the graph, the ones without an owning connection yet are not replicated to anyone */
+	TMap<TObjectKey<AActor>, FMssOwnerOnlyActorRoute> OwnerOnlyActorRoutes;
+
+	/** Returns the per connection node of the connection owning the actor, null when it has no owning client connection **/
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* FindOwnerNode(const AActor* Actor) const;
+
+	/** Adds an owner only actor to the node of its owning connection, or holds it back until it has one */
+	void AddOwnerOnlyActor(const FNewReplicatedActorInfo& ActorInfo);
+
+	void RemoveOwnerOnlyActor(const FNewReplicatedActorInfo& ActorInfo);
+
+	/** Moves owner only actors whose owning connection was set or changed since they were routed, checked every replication frame */
+	void UpdateOwnerOnlyActorRoutes();
+};